@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    snapshot_consumer.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Example program which reads snapshots of running simulator.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "snapshot_reader.h"
+
+/**
+  * @brief  Prints center of mass of Bodies once per second. Slots are read
+  *         in place, without copying.
+  * @retval Exit code.
+  */
+int main(int argc, char *argv[]) {
+  const char *name = argc > 1 ? argv[1] : SNAPSHOT_DEFAULT_NAME;
+  SnapshotReader reader;
+  uint64_t last = 0;
+  uint64_t read = 0;
+  uint64_t missed = 0;
+  std::chrono::steady_clock::time_point report =
+      std::chrono::steady_clock::now();
+
+  for (;;) {
+    // Simulator may not run yet or may have replaced shared memory object.
+    if (!reader.IsOpen() || reader.IsStale()) {
+      if (!reader.Open(name)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        continue;
+      }
+    }
+
+    const uint64_t latest = reader.GetLatest();
+    if (latest == last) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      continue;
+    }
+    if (last != 0 && latest > last + 1)
+      missed += latest - last - 1;
+    last = latest;
+
+    const SnapshotSlot *slot = reader.Acquire(latest);
+    if (!slot)
+      continue;
+    const uint32_t count = slot->count;
+    const uint16_t *xs = reader.GetX(slot);
+    const uint16_t *ys = reader.GetY(slot);
+    const float *masses = reader.GetMasses(slot);
+    double mass = 0.0;
+    double x = 0.0;
+    double y = 0.0;
+    for (uint32_t i = 0; i < count; ++i) {
+      mass += masses[i];
+      x += masses[i] * xs[i];
+      y += masses[i] * ys[i];
+    }
+    const double origin_x = slot->origin_x;
+    const double origin_y = slot->origin_y;
+    const double scale_x = slot->scale_x;
+    const double scale_y = slot->scale_y;
+    const uint64_t step = slot->step;
+    // Result is thrown away if writer overwrote slot in the meantime.
+    if (!reader.Validate(slot, latest) || mass <= 0.0)
+      continue;
+    ++read;
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    if (now - report >= std::chrono::seconds(1)) {
+      printf("step %llu: %u bodies, center of mass (%g, %g), "
+             "%llu snapshots/s read, %llu skipped\n",
+             static_cast<unsigned long long>(step), count,
+             origin_x + x / mass * scale_x, origin_y + y / mass * scale_y,
+             static_cast<unsigned long long>(read),
+             static_cast<unsigned long long>(missed));
+      fflush(stdout);
+      read = 0;
+      missed = 0;
+      report = now;
+    }
+  }
+}
@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file    snapshot_reader.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   SnapshotReader class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "snapshot_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SnapshotReader::SnapshotReader()
+    : memory_(NULL),
+      size_(0),
+      slot_count_(0),
+      capacity_(0) {
+}
+
+SnapshotReader::~SnapshotReader() {
+  Close();
+}
+
+bool SnapshotReader::Open(const char *name) {
+  Close();
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+  struct stat status;
+  void *memory = MAP_FAILED;
+  if (fstat(fd, &status) == 0 &&
+      status.st_size >= static_cast<off_t>(sizeof(SnapshotHeader)))
+    memory = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED)
+    return false;
+
+  // Writer sets magic number after the rest of header.
+  const SnapshotHeader *header = static_cast<const SnapshotHeader*>(memory);
+  bool valid = header->magic == kSnapshotMagic;
+  std::atomic_thread_fence(std::memory_order_acquire);
+  valid = valid && header->version == kSnapshotVersion &&
+          header->slot_count > 0 &&
+          SnapshotObjectSize(header->slot_count, header->capacity) <=
+              static_cast<uint64_t>(status.st_size);
+  if (!valid) {
+    munmap(memory, status.st_size);
+    return false;
+  }
+  memory_ = static_cast<const char*>(memory);
+  size_ = status.st_size;
+  slot_count_ = header->slot_count;
+  capacity_ = header->capacity;
+  return true;
+}
+
+void SnapshotReader::Close() {
+  if (!memory_)
+    return;
+  munmap(const_cast<char*>(memory_), size_);
+  memory_ = NULL;
+  size_ = 0;
+}
+
+bool SnapshotReader::IsOpen() const {
+  return memory_ != NULL;
+}
+
+bool SnapshotReader::IsStale() const {
+  const SnapshotHeader *header =
+      reinterpret_cast<const SnapshotHeader*>(memory_);
+  return !header || header->closed.load(std::memory_order_acquire) != 0;
+}
+
+uint64_t SnapshotReader::GetLatest() const {
+  const SnapshotHeader *header =
+      reinterpret_cast<const SnapshotHeader*>(memory_);
+  return header ? header->latest.load(std::memory_order_acquire) : 0;
+}
+
+const SnapshotSlot *SnapshotReader::Acquire(uint64_t sequence) const {
+  if (!memory_ || sequence == 0)
+    return NULL;
+  const SnapshotSlot *slot = reinterpret_cast<const SnapshotSlot*>(
+      memory_ + SnapshotSlotOffset(slot_count_, capacity_, sequence));
+  if (slot->sequence.load(std::memory_order_acquire) != sequence)
+    return NULL;
+  return slot;
+}
+
+bool SnapshotReader::Validate(const SnapshotSlot *slot,
+                              uint64_t sequence) const {
+  // Reads of slot must not be moved after check of sequence number.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return slot->sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+const uint16_t *SnapshotReader::GetX(const SnapshotSlot *slot) const {
+  return reinterpret_cast<const uint16_t*>(
+      reinterpret_cast<const char*>(slot) + SnapshotXOffset());
+}
+
+const uint16_t *SnapshotReader::GetY(const SnapshotSlot *slot) const {
+  return reinterpret_cast<const uint16_t*>(
+      reinterpret_cast<const char*>(slot) + SnapshotYOffset(capacity_));
+}
+
+const float *SnapshotReader::GetMasses(const SnapshotSlot *slot) const {
+  return reinterpret_cast<const float*>(
+      reinterpret_cast<const char*>(slot) + SnapshotMassesOffset(capacity_));
+}
+
+const uint32_t *SnapshotReader::GetIds(const SnapshotSlot *slot) const {
+  return reinterpret_cast<const uint32_t*>(
+      reinterpret_cast<const char*>(slot) + SnapshotIdsOffset(capacity_));
+}
+
+bool SnapshotReader::Read(uint64_t sequence, Snapshot *snapshot) const {
+  const SnapshotSlot *slot = Acquire(sequence);
+  if (!slot)
+    return false;
+  // Count is checked, because it could be overwritten with garbage.
+  uint32_t count = slot->count;
+  if (count > capacity_)
+    return false;
+  const double origin_x = slot->origin_x;
+  const double origin_y = slot->origin_y;
+  const double scale_x = slot->scale_x;
+  const double scale_y = slot->scale_y;
+  snapshot->sequence = sequence;
+  snapshot->step = slot->step;
+  snapshot->time = slot->time;
+  snapshot->x.resize(count);
+  snapshot->y.resize(count);
+  snapshot->masses.assign(GetMasses(slot), GetMasses(slot) + count);
+  snapshot->ids.assign(GetIds(slot), GetIds(slot) + count);
+  const uint16_t *xs = GetX(slot);
+  const uint16_t *ys = GetY(slot);
+  for (uint32_t i = 0; i < count; ++i) {
+    snapshot->x[i] = origin_x + xs[i] * scale_x;
+    snapshot->y[i] = origin_y + ys[i] * scale_y;
+  }
+  return Validate(slot, sequence);
+}
@@ -0,0 +1,140 @@
+/**
+  ******************************************************************************
+  * @file    snapshot_reader.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of SnapshotReader class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef SNAPSHOT_READER_H
+#define SNAPSHOT_READER_H
+
+// This library does not depend on Qt. It only needs snapshot_format.h from
+// sources of simulator.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "snapshot_format.h"
+
+/**
+  * @brief State of Bodies copied from shared memory.
+  */
+struct Snapshot {
+  uint64_t sequence;
+  uint64_t step;
+  double time;
+  // Positions are already restored from quantized coordinates.
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<float> masses;
+  std::vector<uint32_t> ids;
+};
+
+/**
+  * @brief Reads snapshots published by simulator into POSIX shared memory.
+  *        Readers never block writer. Slot can be overwritten while it is
+  *        read, so every read has to be validated afterwards.
+  */
+class SnapshotReader {
+ public:
+  SnapshotReader();
+
+  /**
+    * @brief SnapshotReader destructor. Unmaps shared memory object.
+    */
+  ~SnapshotReader();
+
+  /**
+    * @brief  Maps shared memory object read-only.
+    * @param  name Name of shared memory object.
+    * @retval Was object opened? Fails if simulator does not publish
+    *         snapshots.
+    */
+  bool Open(const char *name = SNAPSHOT_DEFAULT_NAME);
+
+  /**
+    * @brief Unmaps shared memory object.
+    */
+  void Close();
+
+  /**
+    * @brief  Checks if shared memory object is mapped.
+    * @retval Is object mapped?
+    */
+  bool IsOpen() const;
+
+  /**
+    * @brief  Checks if writer removed object, e.g. because Bodies did not fit
+    *         into it. Reader should be opened again.
+    * @retval Was object removed?
+    */
+  bool IsStale() const;
+
+  /**
+    * @brief  Newest snapshot accessor.
+    * @retval Sequence number of the newest complete snapshot, 0 if there is
+    *         none.
+    */
+  uint64_t GetLatest() const;
+
+  /**
+    * @brief  Finds slot holding snapshot, without copying it. Data read from
+    *         slot is valid only if Validate() returns true afterwards.
+    * @param  sequence Sequence number of snapshot.
+    * @retval Slot, NULL if snapshot was already overwritten.
+    */
+  const SnapshotSlot *Acquire(uint64_t sequence) const;
+
+  /**
+    * @brief  Checks that slot was not overwritten since Acquire().
+    * @param  slot Slot returned by Acquire().
+    * @param  sequence Sequence number of snapshot.
+    * @retval Is everything read from slot valid?
+    */
+  bool Validate(const SnapshotSlot *slot, uint64_t sequence) const;
+
+  // Arrays of slot returned by Acquire().
+  const uint16_t *GetX(const SnapshotSlot *slot) const;
+  const uint16_t *GetY(const SnapshotSlot *slot) const;
+  const float *GetMasses(const SnapshotSlot *slot) const;
+  const uint32_t *GetIds(const SnapshotSlot *slot) const;
+
+  /**
+    * @brief  Copies snapshot.
+    * @param  sequence Sequence number of snapshot.
+    * @param  snapshot Copied snapshot.
+    * @retval False if snapshot was overwritten before or during copying.
+    */
+  bool Read(uint64_t sequence, Snapshot *snapshot) const;
+
+ private:
+  const char *memory_;
+  size_t size_;
+  uint32_t slot_count_;
+  uint32_t capacity_;
+};
+
+#endif // SNAPSHOT_READER_H
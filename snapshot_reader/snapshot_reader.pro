@@ -0,0 +1,24 @@
+#-------------------------------------------------
+#
+# Library for reading snapshots published by simulator through POSIX
+# shared memory, with example consumer. Does not use Qt.
+#
+#-------------------------------------------------
+
+TARGET = snapshot_consumer
+TEMPLATE = app
+
+CONFIG += c++11 thread console
+CONFIG -= qt app_bundle
+
+INCLUDEPATH += ../src
+
+unix:!macx: LIBS += -lrt
+
+SOURCES += \
+    snapshot_consumer.cc \
+    snapshot_reader.cc
+
+HEADERS += \
+    ../src/snapshot_format.h \
+    snapshot_reader.h
@@ -11,16 +11,96 @@ greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 TARGET = 2d_nbody_gravity_simulator
 TEMPLATE = app
 
+CONFIG += c++11 thread
+
+# Lets compiler vectorize summation of gravitational forces. Kernels for
+# newer processors are compiled with target attributes and chosen at startup.
+# Multiply and add are not fused in them, so results stay the same everywhere.
+contains(QMAKE_COMPILER, gcc)|contains(QMAKE_COMPILER, clang) {
+    QMAKE_CXXFLAGS_RELEASE -= -O2
+    QMAKE_CXXFLAGS_RELEASE += -O3 -fno-math-errno
+    QMAKE_CXXFLAGS += -ffp-contract=off
+}
+
+# Shared memory used by snapshots.
+unix:!macx: LIBS += -lrt
+
+# Distributed simulation over MPI, built with "qmake CONFIG+=mpi" and run
+# with "mpirun -np <count> 2d_nbody_gravity_simulator --distributed".
+mpi {
+    DEFINES += HAVE_MPI
+    QMAKE_CXX = mpicxx
+    QMAKE_LINK = mpicxx
+    SOURCES += \
+        distributed_runner.cc \
+        mpi_exchange.cc
+    HEADERS += \
+        distributed_runner.h \
+        distributed_solver.h \
+        mpi_exchange.h
+}
+
 
 SOURCES += \
+    auto_tuner.cc \
+    binary_regularizer.cc \
+    bodies_item.cc \
     body.cc \
+    cpu_features.cc \
+    ensemble_runner.cc \
+    exposure_item.cc \
+    frame_exporter.cc \
+    heatmap_item.cc \
+    hilbert_curve.cc \
+    kepler_drift.cc \
     main.cc \
     mainwindow.cc \
+    neighbor_list.cc \
+    numa_placement.cc \
+    object_pool.cc \
+    presets.cc \
     scene.cc \
-    view.cc
+    simulation.cc \
+    snapshot_writer.cc \
+    spatial_grid.cc \
+    trails_item.cc \
+    view.cc \
+    worker_pool.cc
 
 HEADERS += \
     mainwindow.h \
+    auto_tuner.h \
+    binary_regularizer.h \
+    bodies_item.h \
     body.h \
+    bounded_queue.h \
+    cpu_features.h \
+    direct_solver.h \
+    dormand_prince_integrator.h \
+    ensemble_runner.h \
+    euler_integrator.h \
+    exposure_item.h \
+    first_touch_array.h \
+    frame.h \
+    frame_exporter.h \
+    gravity_kernel.h \
+    heatmap_item.h \
+    hilbert_curve.h \
+    kepler_drift.h \
+    neighbor_list.h \
+    numa_placement.h \
+    object_pool.h \
+    presets.h \
+    runge_kutta_integrator.h \
     scene.h \
-    view.h
+    simulation.h \
+    snapshot_format.h \
+    snapshot_writer.h \
+    softening_kernels.h \
+    spatial_grid.h \
+    stepper.h \
+    tree_solver.h \
+    trails_item.h \
+    view.h \
+    wisdom_holman_integrator.h \
+    worker_pool.h
@@ -0,0 +1,242 @@
+/**
+  ******************************************************************************
+  * @file    auto_tuner.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   AutoTuner class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "auto_tuner.h"
+
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QStringList>
+#include <QSysInfo>
+#include <QThread>
+#include <algorithm>
+#include <cmath>
+
+#include "cpu_features.h"
+
+/**
+  * @brief  Finds range of number of Bodies.
+  * @param  body_count Number of Bodies.
+  * @retval Exponent of the highest power of two not above number of Bodies.
+  */
+static int RangeOf(int body_count) {
+  int range = 0;
+  while (range < 30 && (2 << range) <= body_count)
+    ++range;
+  return range;
+}
+
+/**
+  * @brief  Finds how much longer summing forces of all Bodies takes than
+  *         summing forces of sample.
+  * @param  tree Is Barnes-Hut tree used instead of direct summation?
+  * @param  count Number of all Bodies.
+  * @param  sample_count Number of Bodies in sample.
+  * @retval Ratio of times.
+  */
+static qreal ScaleOf(bool tree, int count, int sample_count) {
+  const qreal ratio = static_cast<qreal>(count) / sample_count;
+  // Direct summation takes O(N^2) time, tree takes O(N log N).
+  if (!tree)
+    return ratio * ratio;
+  return ratio * std::log2(static_cast<qreal>(count)) /
+         std::log2(static_cast<qreal>(sample_count));
+}
+
+AutoTuner::AutoTuner()
+    : accuracy_(kDefaultAccuracy),
+      range_(-1) {}
+
+void AutoTuner::SetAccuracy(qreal accuracy) {
+  accuracy_ = accuracy;
+  Reset();
+}
+
+void AutoTuner::Reset() {
+  range_ = -1;
+}
+
+bool AutoTuner::IsDue(int body_count) const {
+  return RangeOf(body_count) != range_;
+}
+
+AutoTuner::Config AutoTuner::Tune(const QString &policies,
+                                  const Factory &factory,
+                                  int max_thread_count, qreal time_step,
+                                  const QVector<quint32> &ids,
+                                  const QVector<qreal> &masses,
+                                  const QVector<QPointF> &positions,
+                                  const QVector<QPointF> &velocities) {
+  range_ = RangeOf(positions.size());
+  if (max_thread_count <= 0)
+    max_thread_count = QThread::idealThreadCount();
+  Config config = {false, false, max_thread_count};
+  if (positions.size() < kMinBodies)
+    return config;
+
+  // Choices depend on machine and its kernels, on what is integrated and
+  // how accurately, and on number of Bodies.
+  const QString key = QString("%1-%2-%3/%4/%5/%6/%7")
+      .arg(QSysInfo::currentCpuArchitecture())
+      .arg(NameOfInstructionSet(GetInstructionSet()))
+      .arg(QThread::idealThreadCount())
+      .arg(policies)
+      .arg(max_thread_count)
+      .arg(accuracy_)
+      .arg(range_);
+  QSettings settings("2d_nbody_gravity_simulator", "autotuner");
+  const QStringList cached = settings.value(key).toString().split(' ');
+  if (cached.size() == 3) {
+    config.tree = cached.at(0) == "tree";
+    config.single_precision = cached.at(1) == "single";
+    config.thread_count = cached.at(2).toInt();
+    if (config.thread_count > 0 && config.thread_count <= max_thread_count)
+      return config;
+    config.tree = false;
+    config.single_precision = false;
+    config.thread_count = max_thread_count;
+  }
+
+  // Timing all Bodies would take minutes when there are many of them, so
+  // backends are timed on evenly spread sample, which keeps total mass.
+  const int count = positions.size();
+  int sample_count = std::min(count, kMaxSampleBodies);
+  TakeSample(sample_count, ids, masses, positions, velocities);
+
+  // Direct summation in double precision is reference for errors of
+  // others. Backends are compared using all threads.
+  qreal fastest_seconds = Measure(config, factory, time_step) *
+                          ScaleOf(false, count, sample_count);
+  reference_velocities_ = first_velocities_;
+  for (int i = 1; i < 4; ++i) {
+    const Config candidate = {(i & 1) != 0, (i & 2) != 0, max_thread_count};
+    const qreal seconds = Measure(candidate, factory, time_step) *
+                          ScaleOf(candidate.tree, count, sample_count);
+    if (seconds < fastest_seconds && FindError() <= accuracy_) {
+      fastest_seconds = seconds;
+      config = candidate;
+    }
+  }
+
+  // Threads share work of all Bodies but synchronize once per step, so
+  // sample with less work would favour too few threads. They are timed on
+  // all Bodies, unless a step takes so long that all threads pay off.
+  const bool time_threads = count == sample_count ||
+                            fastest_seconds <= kMaxThreadTrialSeconds;
+  if (time_threads && count > sample_count) {
+    sample_count = count;
+    TakeSample(sample_count, ids, masses, positions, velocities);
+    fastest_seconds = Measure(config, factory, time_step);
+  }
+
+  // Halves of thread count are timed with chosen backend. The fewest
+  // threads which are not clearly slower than the fastest count win.
+  // Halving stops at first clearly slower count, as fewer threads only
+  // take longer.
+  QVector<int> thread_counts;
+  QVector<qreal> thread_seconds;
+  thread_counts.append(max_thread_count);
+  thread_seconds.append(fastest_seconds);
+  for (int threads = max_thread_count / 2;
+       threads >= 1 && time_threads; threads /= 2) {
+    Config candidate = config;
+    candidate.thread_count = threads;
+    const qreal seconds = Measure(candidate, factory, time_step);
+    thread_counts.append(threads);
+    thread_seconds.append(seconds);
+    if (seconds * (1.0 - kMinThreadGain) > fastest_seconds)
+      break;
+    fastest_seconds = std::min(fastest_seconds, seconds);
+  }
+  for (int i = 0; i < thread_counts.size(); ++i) {
+    if (thread_seconds.at(i) * (1.0 - kMinThreadGain) <= fastest_seconds)
+      config.thread_count = thread_counts.at(i);
+  }
+
+  settings.setValue(key, QString("%1 %2 %3")
+                             .arg(config.tree ? "tree" : "direct")
+                             .arg(config.single_precision ? "single"
+                                                          : "double")
+                             .arg(config.thread_count));
+  return config;
+}
+
+void AutoTuner::TakeSample(int sample_count, const QVector<quint32> &ids,
+                           const QVector<qreal> &masses,
+                           const QVector<QPointF> &positions,
+                           const QVector<QPointF> &velocities) {
+  const int count = positions.size();
+  const qreal mass_scale = static_cast<qreal>(count) / sample_count;
+  sample_ids_.resize(sample_count);
+  sample_masses_.resize(sample_count);
+  sample_positions_.resize(sample_count);
+  sample_velocities_.resize(sample_count);
+  for (int i = 0; i < sample_count; ++i) {
+    const int index = static_cast<qint64>(i) * count / sample_count;
+    sample_ids_[i] = ids.at(index);
+    sample_masses_[i] = masses.at(index) * mass_scale;
+    sample_positions_[i] = positions.at(index);
+    sample_velocities_[i] = velocities.at(index);
+  }
+}
+
+qreal AutoTuner::Measure(const Config &config, const Factory &factory,
+                         qreal time_step) {
+  WorkerPool pool(config.thread_count);
+  Stepper *stepper = factory(config, &pool);
+  trial_positions_ = sample_positions_;
+  trial_velocities_ = sample_velocities_;
+  stepper->SetIds(sample_ids_);
+  stepper->Advance(time_step, sample_masses_, &trial_positions_,
+                   &trial_velocities_);
+  first_velocities_ = trial_velocities_;
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < kTrialSteps; ++i) {
+    stepper->SetIds(sample_ids_);
+    stepper->Advance(time_step, sample_masses_, &trial_positions_,
+                     &trial_velocities_);
+  }
+  const qreal seconds = timer.nsecsElapsed() * 1e-9 / kTrialSteps;
+  delete stepper;
+  return seconds;
+}
+
+qreal AutoTuner::FindError() const {
+  qreal error = 0.0;
+  qreal change = 0.0;
+  for (int i = 0; i < sample_velocities_.size(); ++i) {
+    const QPointF delta = first_velocities_.at(i) -
+                          reference_velocities_.at(i);
+    const QPointF reference = reference_velocities_.at(i) -
+                              sample_velocities_.at(i);
+    error += delta.x() * delta.x() + delta.y() * delta.y();
+    change += reference.x() * reference.x() + reference.y() * reference.y();
+  }
+  return change > 0.0 ? std::sqrt(error / change) : 0.0;
+}
@@ -0,0 +1,180 @@
+/**
+  ******************************************************************************
+  * @file    auto_tuner.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of AutoTuner class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef AUTO_TUNER_H
+#define AUTO_TUNER_H
+
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+#include "stepper.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Chooses the fastest way of summing forces for current Bodies.
+  *        Candidate configurations are timed for few steps on copy of
+  *        state of evenly spread sample of Bodies, and the fastest one with
+  *        relative error of velocity changes within requested accuracy
+  *        wins. Times of sample are scaled to all Bodies. Number of threads
+  *        is timed on all Bodies, as parallel overhead does not scale like
+  *        work. Choice is cached per hardware, policies and range of number
+  *        of Bodies, so it is measured only once on every machine.
+  */
+class AutoTuner {
+ public:
+  // Configuration of summing gravitational forces.
+  struct Config {
+    // Is Barnes-Hut tree used instead of direct summation?
+    bool tree;
+    // Are forces summed in single precision?
+    bool single_precision;
+    // Number of threads summing forces.
+    int thread_count;
+  };
+
+  // Creates Stepper of given configuration, using given threads.
+  typedef std::function<Stepper*(const Config&, WorkerPool*)> Factory;
+
+  // Default largest relative error of velocity changes in one step.
+  static constexpr qreal kDefaultAccuracy = 1e-3;
+  // Number of timed steps of every candidate, after one untimed step
+  // which also builds state kept by solvers.
+  static constexpr int kTrialSteps = 2;
+  // More threads are chosen only if they are faster by that fraction, as
+  // they also take cores from drawing.
+  static constexpr qreal kMinThreadGain = 0.1;
+  // Fewer Bodies are not worth timing, direct summation is chosen.
+  static constexpr int kMinBodies = 64;
+  // Largest number of Bodies candidates are timed on. It keeps tuning of
+  // any number of Bodies within about second.
+  static constexpr int kMaxSampleBodies = 4096;
+  // Largest estimated time of one step of all Bodies with all threads for
+  // which fewer threads are timed [s]. Slower steps have so much work
+  // that all threads are used.
+  static constexpr qreal kMaxThreadTrialSeconds = 0.05;
+
+  /**
+    * @brief AutoTuner constructor.
+    */
+  AutoTuner();
+
+  /**
+    * @brief Accuracy mutator. Forgets last choice.
+    * @param accuracy Largest relative error of velocity changes in one
+    *        step, compared to direct summation in double precision.
+    */
+  void SetAccuracy(qreal accuracy);
+
+  /**
+    * @brief Forgets last choice, so next check says tuning is due.
+    */
+  void Reset();
+
+  /**
+    * @brief  Checks whether number of Bodies left range of last choice.
+    *         Ranges are powers of two, so merges trigger tuning only after
+    *         number of Bodies changed significantly.
+    * @param  body_count Number of Bodies.
+    * @retval Should configuration be chosen again?
+    */
+  bool IsDue(int body_count) const;
+
+  /**
+    * @brief  Finds cached configuration or times candidates.
+    * @param  policies Name of integration and softening policies, which
+    *         are not changed by tuning, but change its result.
+    * @param  factory Creates Steppers of candidates.
+    * @param  max_thread_count Largest number of threads. Value 0 means
+    *         number of processor cores.
+    * @param  time_step Time step.
+    * @param  ids Ids of Bodies.
+    * @param  masses Masses of Bodies which pull others, 0 for test
+    *         particles.
+    * @param  positions Positions of Bodies.
+    * @param  velocities Velocities of Bodies.
+    * @retval Chosen configuration.
+    */
+  Config Tune(const QString &policies, const Factory &factory,
+              int max_thread_count, qreal time_step,
+              const QVector<quint32> &ids, const QVector<qreal> &masses,
+              const QVector<QPointF> &positions,
+              const QVector<QPointF> &velocities);
+
+ private:
+  /**
+    * @brief Takes evenly spread sample of Bodies, with masses scaled so it
+    *        has mass of all of them.
+    * @param sample_count Number of Bodies in sample.
+    * @param ids Ids of Bodies.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void TakeSample(int sample_count, const QVector<quint32> &ids,
+                  const QVector<qreal> &masses,
+                  const QVector<QPointF> &positions,
+                  const QVector<QPointF> &velocities);
+
+  /**
+    * @brief  Advances copy of state of sample with candidate configuration.
+    * @param  config Candidate configuration.
+    * @param  factory Creates Steppers of candidates.
+    * @param  time_step Time step.
+    * @retval Time of one timed step of sample [s].
+    */
+  qreal Measure(const Config &config, const Factory &factory,
+                qreal time_step);
+
+  /**
+    * @brief  Finds relative error of velocity changes of sample in first
+    *         step of last measurement.
+    * @retval RMS difference from reference changes divided by their RMS.
+    */
+  qreal FindError() const;
+
+  qreal accuracy_;
+  // Range of number of Bodies of last choice, -1 before first one.
+  int range_;
+  // Velocities after first step of reference configuration and of last
+  // measured one.
+  QVector<QPointF> reference_velocities_;
+  QVector<QPointF> first_velocities_;
+  // Sample of Bodies, with masses scaled so it has mass of all of them.
+  QVector<quint32> sample_ids_;
+  QVector<qreal> sample_masses_;
+  QVector<QPointF> sample_positions_;
+  QVector<QPointF> sample_velocities_;
+  // State advanced by candidates.
+  QVector<QPointF> trial_positions_;
+  QVector<QPointF> trial_velocities_;
+};
+
+#endif // AUTO_TUNER_H
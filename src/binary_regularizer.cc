@@ -0,0 +1,322 @@
+/**
+  ******************************************************************************
+  * @file    binary_regularizer.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   BinaryRegularizer class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "binary_regularizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "kepler_drift.h"
+
+BinaryRegularizer::BinaryRegularizer(qreal grav_constant, qreal min_distance)
+    : grav_constant_(grav_constant),
+      min_distance_(min_distance),
+      search_pending_(false) {}
+
+void BinaryRegularizer::Update(bool search, qreal time_step,
+                               const QVector<quint32> &ids,
+                               const QVector<qreal> &masses,
+                               const QVector<QPointF> &positions,
+                               const QVector<QPointF> &velocities) {
+  const int count = positions.size();
+  pairs_.clear();
+  paired_.fill(false, count);
+  qreal period;
+  qreal apocenter;
+  if (search || search_pending_) {
+    search_pending_ = false;
+    // Tight pair is closer than twice its semi-major axis, which is at
+    // most cube root of G (m_i + m_j) T^2 / (4 pi^2) for the longest
+    // allowed period T. Cube root of sum is not greater than sum of cube
+    // roots, so reaches of both Bodies together cover it.
+    const qreal max_period = kStepsPerOrbit * time_step;
+    const qreal reach_factor = 2.0 * std::cbrt(
+        grav_constant_ * max_period * max_period / (4.0 * M_PI * M_PI));
+    reaches_.resize(count);
+    sweep_order_.clear();
+    for (int i = 0; i < count; ++i) {
+      reaches_[i] = reach_factor * std::cbrt(masses.at(i));
+      if (masses.at(i) > 0.0)
+        sweep_order_.append(i);
+    }
+    // Bodies are sorted by left edge of reach, so only pairs which overlap
+    // along x axis are checked.
+    std::sort(sweep_order_.begin(), sweep_order_.end(),
+              [&positions, this](int a, int b) {
+      return positions.at(a).x() - reaches_.at(a) <
+             positions.at(b).x() - reaches_.at(b);
+    });
+    candidates_.clear();
+    for (int a = 0; a < sweep_order_.size(); ++a) {
+      const int i = sweep_order_.at(a);
+      const qreal right = positions.at(i).x() + reaches_.at(i);
+      for (int b = a + 1; b < sweep_order_.size(); ++b) {
+        const int j = sweep_order_.at(b);
+        if (positions.at(j).x() - reaches_.at(j) > right)
+          break;
+        const int low = std::min(i, j);
+        const int high = std::max(i, j);
+        if (IsTight(low, high, time_step, masses, positions, velocities,
+                    &period, &apocenter))
+          candidates_.append(std::make_pair(period,
+                                            std::make_pair(low, high)));
+      }
+    }
+    // The tightest pairs are taken first, each Body joins one pair at most.
+    // Indices break ties, so order in which pairs are found does not matter.
+    std::sort(candidates_.begin(), candidates_.end());
+    for (int c = 0; c < candidates_.size() && c < kMaxCandidates &&
+                    pairs_.size() < kMaxPairs; ++c) {
+      const int i = candidates_.at(c).second.first;
+      const int j = candidates_.at(c).second.second;
+      if (paired_.at(i) || paired_.at(j))
+        continue;
+      IsTight(i, j, time_step, masses, positions, velocities, &period,
+              &apocenter);
+      if (IsIsolated(i, j, apocenter, masses, positions, kMaxTide,
+                     kMinIsolation)) {
+        pairs_.append(std::make_pair(i, j));
+        paired_[i] = true;
+        paired_[j] = true;
+      }
+    }
+  } else if (!pair_ids_.isEmpty()) {
+    // Bodies could be reordered, merged or removed since last step.
+    index_of_.clear();
+    for (int i = 0; i < count; ++i)
+      index_of_.insert(ids.at(i), i);
+    for (int p = 0; p < pair_ids_.size(); ++p) {
+      const int i = index_of_.value(pair_ids_.at(p).first, -1);
+      const int j = index_of_.value(pair_ids_.at(p).second, -1);
+      if (i >= 0 && j >= 0 &&
+          IsTight(i, j, time_step, masses, positions, velocities, &period,
+                  &apocenter) &&
+          IsIsolated(i, j, apocenter, masses, positions, kMaxKeptTide,
+                     kMinKeptIsolation))
+        pairs_.append(std::make_pair(i, j));
+      else
+        search_pending_ = true;
+    }
+  }
+
+  pair_ids_.resize(pairs_.size());
+  for (int p = 0; p < pairs_.size(); ++p) {
+    pair_ids_[p] = std::make_pair(ids.at(pairs_.at(p).first),
+                                  ids.at(pairs_.at(p).second));
+  }
+}
+
+bool BinaryRegularizer::IsEmpty() const {
+  return pairs_.isEmpty();
+}
+
+void BinaryRegularizer::Join(qreal time_step, const QVector<quint32> &ids,
+                             const QVector<qreal> &masses,
+                             const QVector<QPointF> &positions,
+                             const QVector<QPointF> &velocities,
+                             QVector<quint32> *bulk_ids,
+                             QVector<qreal> *bulk_masses,
+                             QVector<QPointF> *bulk_positions,
+                             QVector<QPointF> *bulk_velocities) {
+  const int count = positions.size();
+  // Second Body of each pair shares place of first one in bulk arrays.
+  bulk_index_.fill(0, count);
+  for (int p = 0; p < pairs_.size(); ++p)
+    bulk_index_[pairs_.at(p).second] = -1;
+  int bulk_count = 0;
+  for (int i = 0; i < count; ++i) {
+    if (bulk_index_.at(i) >= 0)
+      bulk_index_[i] = bulk_count++;
+  }
+  bulk_ids->resize(bulk_count);
+  bulk_masses->resize(bulk_count);
+  bulk_positions->resize(bulk_count);
+  bulk_velocities->resize(bulk_count);
+  for (int i = 0; i < count; ++i) {
+    const int bulk = bulk_index_.at(i);
+    if (bulk >= 0) {
+      (*bulk_ids)[bulk] = ids.at(i);
+      (*bulk_masses)[bulk] = masses.at(i);
+      (*bulk_positions)[bulk] = positions.at(i);
+      (*bulk_velocities)[bulk] = velocities.at(i);
+    }
+  }
+
+  relative_positions_.resize(pairs_.size());
+  relative_velocities_.resize(pairs_.size());
+  for (int p = 0; p < pairs_.size(); ++p) {
+    const int i = pairs_.at(p).first;
+    const int j = pairs_.at(p).second;
+    const int bulk = bulk_index_.at(i);
+    bulk_index_[j] = bulk;
+    const qreal mass = masses.at(i) + masses.at(j);
+    (*bulk_masses)[bulk] = mass;
+    (*bulk_positions)[bulk] = (positions.at(i) * masses.at(i) +
+                               positions.at(j) * masses.at(j)) / mass;
+    (*bulk_velocities)[bulk] = (velocities.at(i) * masses.at(i) +
+                                velocities.at(j) * masses.at(j)) / mass;
+    relative_positions_[p] = positions.at(j) - positions.at(i);
+    relative_velocities_[p] = velocities.at(j) - velocities.at(i);
+  }
+  KickByTides(time_step / 2.0, masses, positions);
+}
+
+void BinaryRegularizer::Split(qreal time_step, const QVector<qreal> &masses,
+                              const QVector<QPointF> &bulk_positions,
+                              const QVector<QPointF> &bulk_velocities,
+                              QVector<QPointF> *positions,
+                              QVector<QPointF> *velocities) {
+  const int count = positions->size();
+  for (int i = 0; i < count; ++i) {
+    (*positions)[i] = bulk_positions.at(bulk_index_.at(i));
+    (*velocities)[i] = bulk_velocities.at(bulk_index_.at(i));
+  }
+  for (int p = 0; p < pairs_.size(); ++p) {
+    const int i = pairs_.at(p).first;
+    const int j = pairs_.at(p).second;
+    const qreal mass = masses.at(i) + masses.at(j);
+    KeplerDrift(grav_constant_ * mass, time_step, &relative_positions_[p],
+                &relative_velocities_[p]);
+    const QPointF barycenter = positions->at(i);
+    (*positions)[i] = barycenter -
+                      relative_positions_.at(p) * (masses.at(j) / mass);
+    (*positions)[j] = barycenter +
+                      relative_positions_.at(p) * (masses.at(i) / mass);
+  }
+  // Tides are found at advanced positions of all Bodies.
+  KickByTides(time_step / 2.0, masses, *positions);
+  for (int p = 0; p < pairs_.size(); ++p) {
+    const int i = pairs_.at(p).first;
+    const int j = pairs_.at(p).second;
+    const qreal mass = masses.at(i) + masses.at(j);
+    const QPointF velocity = velocities->at(i);
+    (*velocities)[i] = velocity -
+                       relative_velocities_.at(p) * (masses.at(j) / mass);
+    (*velocities)[j] = velocity +
+                       relative_velocities_.at(p) * (masses.at(i) / mass);
+  }
+}
+
+bool BinaryRegularizer::IsTight(int i, int j, qreal time_step,
+                                const QVector<qreal> &masses,
+                                const QVector<QPointF> &positions,
+                                const QVector<QPointF> &velocities,
+                                qreal *period, qreal *apocenter) const {
+  const qreal mu = grav_constant_ * (masses.at(i) + masses.at(j));
+  if (!(mu > 0.0))
+    return false;
+  // Bound orbit is never wider than twice its semi-major axis, which has
+  // to be shorter than that of orbit with the longest allowed period.
+  const qreal max_period = kStepsPerOrbit * time_step;
+  const qreal max_axis_cubed = mu * max_period * max_period /
+                               (4.0 * M_PI * M_PI);
+  const QPointF delta = positions.at(j) - positions.at(i);
+  const qreal distance_squared = delta.x() * delta.x() +
+                                 delta.y() * delta.y();
+  if (distance_squared * distance_squared * distance_squared >=
+      64.0 * max_axis_cubed * max_axis_cubed ||
+      distance_squared == 0.0)
+    return false;
+
+  const QPointF velocity = velocities.at(j) - velocities.at(i);
+  const qreal distance = std::sqrt(distance_squared);
+  const qreal energy = (velocity.x() * velocity.x() +
+                        velocity.y() * velocity.y()) / 2.0 - mu / distance;
+  if (energy >= 0.0)
+    return false;
+  const qreal axis = -mu / (2.0 * energy);
+  if (axis * axis * axis >= max_axis_cubed)
+    return false;
+  *period = 2.0 * M_PI * std::sqrt(axis * axis * axis / mu);
+  const qreal momentum = delta.x() * velocity.y() - delta.y() * velocity.x();
+  const qreal eccentricity = std::sqrt(
+      std::max(1.0 + 2.0 * energy * momentum * momentum / (mu * mu), 0.0));
+  *apocenter = axis * (1.0 + eccentricity);
+  return true;
+}
+
+bool BinaryRegularizer::IsIsolated(int i, int j, qreal apocenter,
+                                   const QVector<qreal> &masses,
+                                   const QVector<QPointF> &positions,
+                                   qreal max_tide,
+                                   qreal min_distance) const {
+  const qreal mass = masses.at(i) + masses.at(j);
+  const QPointF barycenter = (positions.at(i) * masses.at(i) +
+                              positions.at(j) * masses.at(j)) / mass;
+  // Tide of Body at distance d is about 2 G m Q^3 / d^3 of pull inside
+  // pair G M / Q^2, where Q is apocenter.
+  const qreal max_sum = max_tide * mass /
+                        (2.0 * apocenter * apocenter * apocenter);
+  const qreal min_distance_squared = min_distance * min_distance *
+                                     apocenter * apocenter;
+  qreal sum = 0.0;
+  for (int k = 0; k < positions.size(); ++k) {
+    // Test particles do not disturb pairs.
+    if (k == i || k == j || !(masses.at(k) > 0.0))
+      continue;
+    const QPointF delta = positions.at(k) - barycenter;
+    const qreal distance_squared = delta.x() * delta.x() +
+                                   delta.y() * delta.y();
+    if (distance_squared < min_distance_squared)
+      return false;
+    sum += masses.at(k) / (distance_squared * std::sqrt(distance_squared));
+    if (sum > max_sum)
+      return false;
+  }
+  return true;
+}
+
+void BinaryRegularizer::KickByTides(qreal time,
+                                    const QVector<qreal> &masses,
+                                    const QVector<QPointF> &positions) {
+  for (int p = 0; p < pairs_.size(); ++p) {
+    const int i = pairs_.at(p).first;
+    const int j = pairs_.at(p).second;
+    // Tide is difference of pulls of other Bodies on Bodies of pair.
+    QPointF tide(0.0, 0.0);
+    for (int k = 0; k < positions.size(); ++k) {
+      if (k == i || k == j || !(masses.at(k) > 0.0))
+        continue;
+      const QPointF delta_i = positions.at(k) - positions.at(i);
+      const QPointF delta_j = positions.at(k) - positions.at(j);
+      const qreal distance_i = std::sqrt(delta_i.x() * delta_i.x() +
+                                         delta_i.y() * delta_i.y());
+      const qreal distance_j = std::sqrt(delta_j.x() * delta_j.x() +
+                                         delta_j.y() * delta_j.y());
+      if (distance_i > min_distance_) {
+        tide -= delta_i * (masses.at(k) /
+                           (distance_i * distance_i * distance_i));
+      }
+      if (distance_j > min_distance_) {
+        tide += delta_j * (masses.at(k) /
+                           (distance_j * distance_j * distance_j));
+      }
+    }
+    relative_velocities_[p] += tide * (grav_constant_ * time);
+  }
+}
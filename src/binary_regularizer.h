@@ -0,0 +1,202 @@
+/**
+  ******************************************************************************
+  * @file    binary_regularizer.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of BinaryRegularizer class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef BINARY_REGULARIZER_H
+#define BINARY_REGULARIZER_H
+
+#include <QHash>
+#include <QPointF>
+#include <QVector>
+#include <utility>
+
+/**
+  * @brief Integrates tight pairs of Bodies separately from the rest of
+  *        simulation. Each pair is replaced by one Body at its barycenter,
+  *        which is advanced by Stepper with others, while relative motion
+  *        of pair follows exact Kepler orbit, kicked by tides of other
+  *        Bodies. Time step is then limited by the bulk of Bodies, not by
+  *        the closest pair.
+  */
+class BinaryRegularizer {
+ public:
+  // Number of steps between searches of close pairs of Bodies. Known
+  // pairs are checked in every step.
+  static constexpr int kSearchInterval = 16;
+  // Isolation and tides of every pair are found from all Bodies, so number
+  // of pairs and of candidates checked in one search are limited. The
+  // tightest ones are taken first.
+  static constexpr int kMaxPairs = 64;
+  static constexpr int kMaxCandidates = 256;
+  // Pairs which orbit each other in fewer steps than that are regularized.
+  static constexpr qreal kStepsPerOrbit = 100.0;
+  // Largest ratio of tides of other Bodies to pull between Bodies of new
+  // pair, and smallest distance of other Bodies in apocenters of pair.
+  static constexpr qreal kMaxTide = 0.01;
+  static constexpr qreal kMinIsolation = 4.0;
+  // The same limits for pairs which are kept. They are looser, so pairs
+  // survive flybys which only perturb them.
+  static constexpr qreal kMaxKeptTide = 0.25;
+  static constexpr qreal kMinKeptIsolation = 2.0;
+
+  /**
+    * @brief BinaryRegularizer constructor.
+    * @param grav_constant Gravitational constant.
+    * @param min_distance Bodies closer than that do not pull each other.
+    */
+  BinaryRegularizer(qreal grav_constant, qreal min_distance);
+
+  /**
+    * @brief Finds tight pairs of Bodies at beginning of step.
+    * @param search Should close pairs be searched? Otherwise only pairs
+    *        found earlier are checked, unless some of them was broken.
+    * @param time_step Time step.
+    * @param ids Identifiers of Bodies.
+    * @param masses Masses of Bodies, 0 for test particles.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void Update(bool search, qreal time_step, const QVector<quint32> &ids,
+              const QVector<qreal> &masses,
+              const QVector<QPointF> &positions,
+              const QVector<QPointF> &velocities);
+
+  /**
+    * @brief  Checks if any pair is regularized.
+    * @retval Is there no pair?
+    */
+  bool IsEmpty() const;
+
+  /**
+    * @brief Replaces each pair by one Body at its barycenter and kicks
+    *        relative motion of pairs by tides for half of time step.
+    * @param time_step Time step.
+    * @param ids Ids of Bodies.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    * @param bulk_ids Ids of Bodies with pairs joined. Barycenter takes id
+    *        of first Body of pair.
+    * @param bulk_masses Masses of Bodies with pairs joined.
+    * @param bulk_positions Positions of Bodies with pairs joined.
+    * @param bulk_velocities Velocities of Bodies with pairs joined.
+    */
+  void Join(qreal time_step, const QVector<quint32> &ids,
+            const QVector<qreal> &masses, const QVector<QPointF> &positions,
+            const QVector<QPointF> &velocities, QVector<quint32> *bulk_ids,
+            QVector<qreal> *bulk_masses, QVector<QPointF> *bulk_positions,
+            QVector<QPointF> *bulk_velocities);
+
+  /**
+    * @brief Moves pairs along Kepler orbits for time step, places them
+    *        around their advanced barycenters and kicks them by tides for
+    *        second half of time step.
+    * @param time_step Time step.
+    * @param masses Masses of Bodies.
+    * @param bulk_positions Advanced positions of Bodies with pairs joined.
+    * @param bulk_velocities Advanced velocities of Bodies with pairs joined.
+    * @param positions Advanced positions of Bodies.
+    * @param velocities Advanced velocities of Bodies.
+    */
+  void Split(qreal time_step, const QVector<qreal> &masses,
+             const QVector<QPointF> &bulk_positions,
+             const QVector<QPointF> &bulk_velocities,
+             QVector<QPointF> *positions, QVector<QPointF> *velocities);
+
+ private:
+  /**
+    * @brief  Checks if Bodies form pair which is too tight for time step.
+    * @param  i Index of Body 1.
+    * @param  j Index of Body 2.
+    * @param  time_step Time step.
+    * @param  masses Masses of Bodies.
+    * @param  positions Positions of Bodies.
+    * @param  velocities Velocities of Bodies.
+    * @param  period Orbital period of pair.
+    * @param  apocenter Greatest distance between Bodies on their orbit.
+    * @retval Are Bodies bound and orbiting faster than time step allows?
+    */
+  bool IsTight(int i, int j, qreal time_step, const QVector<qreal> &masses,
+               const QVector<QPointF> &positions,
+               const QVector<QPointF> &velocities, qreal *period,
+               qreal *apocenter) const;
+
+  /**
+    * @brief  Checks if other Bodies are far enough from pair, so their tides
+    *         only perturb its orbit.
+    * @param  i Index of Body 1.
+    * @param  j Index of Body 2.
+    * @param  apocenter Greatest distance between Bodies on their orbit.
+    * @param  masses Masses of Bodies.
+    * @param  positions Positions of Bodies.
+    * @param  max_tide Largest allowed ratio of tides to pull inside pair.
+    * @param  min_distance Smallest allowed distance of other Bodies in
+    *         apocenters. Closer Bodies would feel pair as one.
+    * @retval Are tides weak enough and other Bodies far enough?
+    */
+  bool IsIsolated(int i, int j, qreal apocenter,
+                  const QVector<qreal> &masses,
+                  const QVector<QPointF> &positions, qreal max_tide,
+                  qreal min_distance) const;
+
+  /**
+    * @brief Changes relative velocities of pairs by tides of other Bodies.
+    * @param time Duration of kick.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    */
+  void KickByTides(qreal time, const QVector<qreal> &masses,
+                   const QVector<QPointF> &positions);
+
+  qreal grav_constant_;
+  qreal min_distance_;
+  // Is search needed in next step, because some pair was broken?
+  bool search_pending_;
+  // Identifiers of Bodies in pairs, kept between steps.
+  QVector<std::pair<quint32, quint32> > pair_ids_;
+  // Indices of Bodies in pairs in current step.
+  QVector<std::pair<int, int> > pairs_;
+  // Index of each Body in bulk arrays.
+  QVector<int> bulk_index_;
+  // Position and velocity of second Body of each pair relative to first.
+  QVector<QPointF> relative_positions_;
+  QVector<QPointF> relative_velocities_;
+  // Index of each Body by its identifier.
+  QHash<quint32, int> index_of_;
+  // Is Body in pair already? Used during search.
+  QVector<bool> paired_;
+  // Distance at which Body can form tight pair with any other. Pair can be
+  // tight only if sum of their reaches is longer than distance of Bodies.
+  QVector<qreal> reaches_;
+  // Indices of Bodies which pull others, sorted by left edge of reach
+  // during search. Test particles never form pairs.
+  QVector<int> sweep_order_;
+  // Candidates for pairs sorted by period during search.
+  QVector<std::pair<qreal, std::pair<int, int> > > candidates_;
+};
+
+#endif // BINARY_REGULARIZER_H
@@ -0,0 +1,192 @@
+/**
+  ******************************************************************************
+  * @file    bodies_item.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   BodiesItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "bodies_item.h"
+
+#include <QImage>
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+
+BodiesItem::BodiesItem()
+    : QGraphicsItem(),
+      atlas_antialiased_(false) {
+  setZValue(1);
+  // Needed for exposed rectangle to be passed to paint().
+  setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void BodiesItem::Sync(const Frame &frame) {
+  // Vectors are shared with Frame, not copied.
+  positions_ = frame.positions;
+  radii_ = frame.radii;
+  const int count = positions_.size();
+  color_buckets_.resize(count);
+
+  qreal left = 0.0;
+  qreal right = 0.0;
+  qreal top = 0.0;
+  qreal bottom = 0.0;
+  qreal max_radius = 0.0;
+  for (int i = 0; i < count; ++i) {
+    const QPointF &position = positions_.at(i);
+    const qreal radius = radii_.at(i);
+    color_buckets_[i] = ColorBucket(frame.masses.at(i));
+    if (i == 0 || position.x() < left)
+      left = position.x();
+    if (i == 0 || position.x() > right)
+      right = position.x();
+    if (i == 0 || position.y() < top)
+      top = position.y();
+    if (i == 0 || position.y() > bottom)
+      bottom = position.y();
+    max_radius = std::max(max_radius, radius);
+  }
+
+  QRectF centers(QPointF(left, top), QPointF(right, bottom));
+  grid_.Build(positions_, centers, max_radius);
+  QRectF rect = centers.adjusted(-max_radius, -max_radius,
+                                 max_radius, max_radius);
+  if (rect != bounding_rect_) {
+    prepareGeometryChange();
+    bounding_rect_ = rect;
+  }
+  update();
+}
+
+QRectF BodiesItem::boundingRect() const {
+  return bounding_rect_;
+}
+
+void BodiesItem::paint(QPainter *painter,
+                       const QStyleOptionGraphicsItem *option,
+                       QWidget *widget) {
+  Q_UNUSED(widget);
+  bool antialiasing = painter->testRenderHint(QPainter::Antialiasing);
+  if (atlas_.isNull() || atlas_antialiased_ != antialiasing)
+    CreateAtlas(antialiasing);
+
+  const QRectF exposed = option->exposedRect;
+  const QTransform transform = painter->worldTransform();
+  // View is only scaled and translated, so one factor describes zoom.
+  const qreal scale = transform.m11();
+  fragments_.clear();
+  points_.resize(kColorBuckets);
+  for (int i = 0; i < kColorBuckets; ++i)
+    points_[i].clear();
+  visible_.clear();
+  grid_.Query(exposed, &visible_);
+  painter->setPen(Qt::NoPen);
+  foreach (int i, visible_) {
+    const QPointF &position = positions_.at(i);
+    const qreal radius = radii_.at(i);
+    // Grid cells can stick out of exposed rectangle.
+    if (position.x() + radius < exposed.left() ||
+        position.x() - radius > exposed.right() ||
+        position.y() + radius < exposed.top() ||
+        position.y() - radius > exposed.bottom())
+      continue;
+
+    const qreal screen_radius = radius * scale;
+    if (screen_radius < kPointRadius) {
+      points_[color_buckets_.at(i)].append(transform.map(position));
+      continue;
+    }
+    int bucket = qRound(screen_radius / kSpriteRadiusStep) - 1;
+    if (bucket >= kRadiusBuckets) {
+      // There are only few big Bodies on screen, so they are drawn directly.
+      painter->setBrush(BucketColor(color_buckets_.at(i)));
+      painter->drawEllipse(position, radius, radius);
+      continue;
+    }
+    bucket = std::max(bucket, 0);
+    const int side = SpriteSide(bucket);
+    QRectF source(color_buckets_.at(i) * side, atlas_rows_.at(bucket),
+                  side, side);
+    fragments_.append(
+        QPainter::PixmapFragment::create(transform.map(position), source));
+  }
+
+  // Fragments and points are positioned in device coordinates.
+  painter->save();
+  painter->resetTransform();
+  painter->drawPixmapFragments(fragments_.constData(), fragments_.size(),
+                               atlas_);
+  for (int i = 0; i < kColorBuckets; ++i) {
+    if (!points_.at(i).isEmpty()) {
+      painter->setPen(QPen(BucketColor(i), 1.0));
+      painter->drawPoints(points_.at(i).constData(), points_.at(i).size());
+    }
+  }
+  painter->restore();
+}
+
+int BodiesItem::ColorBucket(qreal mass) {
+  // Colour of Body stops changing above mass of 1000000.
+  int bucket = qRound(mass / 1000000.0 * (kColorBuckets - 1));
+  return qBound(0, bucket, kColorBuckets - 1);
+}
+
+QColor BodiesItem::BucketColor(int bucket) {
+  return Body::ColorOfMass(bucket * 1000000.0 / (kColorBuckets - 1));
+}
+
+int BodiesItem::SpriteSide(int bucket) {
+  // One pixel of margin on each side leaves room for antialiasing.
+  return 2 * qCeil((bucket + 1) * kSpriteRadiusStep) + 2;
+}
+
+void BodiesItem::CreateAtlas(bool antialiasing) {
+  atlas_rows_.resize(kRadiusBuckets);
+  int height = 0;
+  for (int i = 0; i < kRadiusBuckets; ++i) {
+    atlas_rows_[i] = height;
+    height += SpriteSide(i);
+  }
+  const int width = kColorBuckets * SpriteSide(kRadiusBuckets - 1);
+
+  QImage atlas(width, height, QImage::Format_ARGB32_Premultiplied);
+  atlas.fill(Qt::transparent);
+  QPainter painter(&atlas);
+  painter.setRenderHint(QPainter::Antialiasing, antialiasing);
+  painter.setPen(Qt::NoPen);
+  for (int i = 0; i < kRadiusBuckets; ++i) {
+    const int side = SpriteSide(i);
+    const qreal radius = (i + 1) * kSpriteRadiusStep;
+    for (int j = 0; j < kColorBuckets; ++j) {
+      painter.setBrush(BucketColor(j));
+      painter.drawEllipse(QPointF(j * side + side / 2.0,
+                                  atlas_rows_.at(i) + side / 2.0),
+                          radius, radius);
+    }
+  }
+  painter.end();
+
+  atlas_ = QPixmap::fromImage(atlas);
+  atlas_antialiased_ = antialiasing;
+}
@@ -0,0 +1,134 @@
+/**
+  ******************************************************************************
+  * @file    bodies_item.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of BodiesItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef BODIES_ITEM_H
+#define BODIES_ITEM_H
+
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QPixmap>
+#include <QVector>
+
+#include "body.h"
+#include "frame.h"
+#include "spatial_grid.h"
+
+/**
+  * @brief Single graphics item which draws all Bodies in one paint call.
+  *        Only Bodies found in exposed rectangle by SpatialGrid are drawn.
+  *        Small Bodies are drawn as sprites from shared atlas, in which
+  *        there is one sprite for every radius and colour bucket. Bodies
+  *        smaller than pixel are drawn as points.
+  */
+class BodiesItem : public QGraphicsItem {
+ public:
+  // Number of buckets into which colours of Bodies are quantized.
+  static constexpr int kColorBuckets = 32;
+  // Step of on-screen radius between neighbouring sprites [px].
+  static constexpr qreal kSpriteRadiusStep = 0.5;
+  // Number of sprite radiuses. Bigger Bodies are drawn as ellipses.
+  static constexpr int kRadiusBuckets = 32;
+  // Bodies with smaller radius on screen are drawn as points [px].
+  static constexpr qreal kPointRadius = 0.5;
+
+  /**
+    * @brief BodiesItem constructor.
+    */
+  BodiesItem();
+
+  /**
+    * @brief Takes state of Bodies to be drawn.
+    * @param frame State of Bodies.
+    */
+  void Sync(const Frame &frame);
+
+  /**
+    * @brief  Bounding rectangle accessor.
+    * @retval Rectangle containing all Bodies.
+    */
+  QRectF boundingRect() const;
+
+  /**
+    * @brief Draws all Bodies which are inside exposed rectangle.
+    * @param painter Painter.
+    * @param option Style options with exposed rectangle.
+    * @param widget Widget being painted on.
+    */
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+             QWidget *widget);
+
+ private:
+  /**
+    * @brief  Finds colour bucket of Body with given mass.
+    * @param  mass Mass of Body.
+    * @retval Index of colour bucket.
+    */
+  static int ColorBucket(qreal mass);
+
+  /**
+    * @brief  Finds colour of given colour bucket.
+    * @param  bucket Index of colour bucket.
+    * @retval Colour of bucket.
+    */
+  static QColor BucketColor(int bucket);
+
+  /**
+    * @brief  Finds size of sprite in atlas.
+    * @param  bucket Index of radius bucket.
+    * @retval Length of side of sprite [px].
+    */
+  static int SpriteSide(int bucket);
+
+  /**
+    * @brief Renders all sprites into atlas.
+    * @param antialiasing Should sprites be antialiased?
+    */
+  void CreateAtlas(bool antialiasing);
+
+  // State of Bodies taken during last Sync().
+  QVector<QPointF> positions_;
+  QVector<qreal> radii_;
+  QVector<int> color_buckets_;
+  QRectF bounding_rect_;
+  // Bodies sorted by position.
+  SpatialGrid grid_;
+  // Indices of Bodies found in exposed rectangle during last paint call.
+  QVector<int> visible_;
+  // Positions on screen of Bodies drawn as points, for every colour bucket.
+  QVector<QVector<QPointF> > points_;
+  // All sprites, one row per radius bucket and one column per colour bucket.
+  QPixmap atlas_;
+  bool atlas_antialiased_;
+  // Vertical offsets of rows of atlas.
+  QVector<int> atlas_rows_;
+  // Fragments of atlas drawn in last paint call. Kept to avoid reallocation.
+  QVector<QPainter::PixmapFragment> fragments_;
+};
+
+#endif // BODIES_ITEM_H
@@ -29,32 +29,92 @@
 
 #include "body.h"
 
-#include <QGraphicsScene>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/**
+  * @brief  Pool accessor. Pool is created on first use.
+  * @retval Pool of memory of all Bodies.
+  */
+static ObjectPool &Pool() {
+  static ObjectPool pool(sizeof(Body));
+  return pool;
+}
+
+// Pools of trails of each length. One mutex guards all of them, so pool is
+// not released while other Body takes trail from it.
+struct TrailPools {
+  std::mutex mutex;
+  std::map<int, std::unique_ptr<ObjectPool> > pools;
+};
+
+/**
+  * @brief  Trail pools accessor. Pools are created on first use.
+  * @retval Pools of memory of trails of all lengths.
+  */
+static TrailPools &GetTrailPools() {
+  static TrailPools trail_pools;
+  return trail_pools;
+}
+
+/**
+  * @brief  Takes memory for trail from pool of its length, creating pool
+  *         if needed.
+  * @param  length Number of positions in trail.
+  * @param  pool Pool which trail is taken from.
+  * @retval Uninitialized memory of trail.
+  */
+static QPointF *AllocateTrail(int length, ObjectPool **pool) {
+  TrailPools &trail_pools = GetTrailPools();
+  std::lock_guard<std::mutex> lock(trail_pools.mutex);
+  std::unique_ptr<ObjectPool> &length_pool = trail_pools.pools[length];
+  if (!length_pool)
+    length_pool.reset(new ObjectPool(length * sizeof(QPointF)));
+  *pool = length_pool.get();
+  return static_cast<QPointF*>(length_pool->Allocate());
+}
+
+/**
+  * @brief Returns memory of trail to its pool. Pool which is left empty is
+  *        released, so lengths which are no longer used keep no memory.
+  * @param length Number of positions in trail.
+  * @param trail Memory taken by AllocateTrail().
+  */
+static void FreeTrail(int length, QPointF *trail) {
+  TrailPools &trail_pools = GetTrailPools();
+  std::lock_guard<std::mutex> lock(trail_pools.mutex);
+  auto pool = trail_pools.pools.find(length);
+  pool->second->Free(trail);
+  if (pool->second->GetUsedCount() == 0)
+    trail_pools.pools.erase(pool);
+}
 
 Body::Body(qreal mass, qreal radius, QPointF vel, QPointF pos)
-    : QGraphicsEllipseItem(),
-      trail_iterator_(0),
-      last_position_(pos),
-      k1dx_(QPointF(0.0, 0.0)),
-      k1dv_(QPointF(0.0, 0.0)),
-      k2dx_(QPointF(0.0, 0.0)),
-      k2dv_(QPointF(0.0, 0.0)),
-      k3dx_(QPointF(0.0, 0.0)),
-      k3dv_(QPointF(0.0, 0.0)),
-      k4dx_(QPointF(0.0, 0.0)),
-      k4dv_(QPointF(0.0, 0.0)),
-      velocity_(vel) {
+    : id_(0),
+      test_particle_(false),
+      position_(pos),
+      velocity_(vel),
+      trail_(NULL),
+      trail_length_(0),
+      trail_pool_(NULL),
+      trail_head_(0),
+      trail_size_(0) {
   SetMass(mass);
   SetRadius(radius);
-  setPos(pos);
-  setZValue(1);
-  setCacheMode(QGraphicsItem::DeviceCoordinateCache);
-  setPen(Qt::NoPen);
 }
 
 Body::~Body() {
-  foreach (QGraphicsLineItem *trail, trails_)
-    delete trail;
+  SetTrailLength(0);
+}
+
+quint32 Body::GetId() const {
+  return id_;
+}
+
+void Body::SetId(quint32 id) {
+  id_ = id;
 }
 
 qreal Body::GetRadius() const {
@@ -63,7 +123,6 @@ qreal Body::GetRadius() const {
 
 void Body::SetRadius(qreal radius) {
   radius_ = radius;
-  setRect(-radius_, -radius_, 2.0 * radius_, 2.0 * radius_);
 }
 
 qreal Body::GetMass() const {
@@ -72,17 +131,35 @@ qreal Body::GetMass() const {
 
 void Body::SetMass(qreal mass) {
   mass_ = mass;
+}
+
+bool Body::IsTestParticle() const {
+  return test_particle_;
+}
+
+void Body::SetTestParticle(bool test_particle) {
+  test_particle_ = test_particle;
+}
 
+QColor Body::ColorOfMass(qreal mass) {
   // Setting colour of Body depending on its mass.
   QColor color;
-  if (mass_ < 500000) {
-    qreal value = std::min(255 * mass_ / 500000, 255.0);
+  if (mass < 500000) {
+    qreal value = std::min(255 * mass / 500000, 255.0);
     color = QColor(value, 255, 0);
   } else {
-    qreal value = std::max(255 - 255 * (mass_ - 500000) / 500000, 0.0);
+    qreal value = std::max(255 - 255 * (mass - 500000) / 500000, 0.0);
     color = QColor(255, value, 0);
   }
-  setBrush(QBrush(color));
+  return color;
+}
+
+QPointF Body::GetPosition() const {
+  return position_;
+}
+
+void Body::SetPosition(QPointF position) {
+  position_ = position;
 }
 
 QPointF Body::GetVelocity() const {
@@ -97,26 +174,89 @@ void Body::SetVelocity(qreal vel_x, qreal vel_y) {
   velocity_ = QPointF(vel_x, vel_y);
 }
 
-void Body::CreateTrails(qreal view_scale) {
-  last_position_ = pos();
-  QGraphicsLineItem *trail;
-  for (int i = 0; i < kTrailCount; ++i) {
-    trail = new QGraphicsLineItem();
-    trails_.append(trail);
-    scene()->addItem(trail);
-    trail->setPen(QPen(QColor(255, 255, 255)));
-    trail->setPos(0, 0);
-    trail->setLine(pos().x(), pos().y(), pos().x(), pos().y());
-    // Trail's size in Scene depends of current zoom of View, so the visible
-    // size stays the same.
-    trail->setPen(QPen(Qt::white, 0.25 / view_scale));
+void Body::SetTrailLength(int length) {
+  if (length == trail_length_)
+    return;
+  int size = std::min(trail_size_, length);
+  QPointF *trail = NULL;
+  ObjectPool *trail_pool = NULL;
+  if (length > 0) {
+    trail = AllocateTrail(length, &trail_pool);
+    std::uninitialized_fill_n(trail, length, QPointF());
+    for (int i = 0; i < size; ++i)
+      trail[i] = GetTrailPoint(trail_size_ - size + i);
   }
+  // QPointF does not need to be destroyed.
+  if (trail_ != NULL)
+    FreeTrail(trail_length_, trail_);
+  trail_ = trail;
+  trail_length_ = length;
+  trail_pool_ = trail_pool;
+  trail_size_ = size;
+  trail_head_ = length > 0 ? size % length : 0;
+}
+
+void Body::RecordTrail() {
+  if (trail_length_ == 0)
+    return;
+  trail_[trail_head_] = position_;
+  trail_head_ = (trail_head_ + 1) % trail_length_;
+  if (trail_size_ < trail_length_)
+    ++trail_size_;
 }
 
-void Body::DeleteTrails() {
-  foreach (QGraphicsLineItem *trail, trails_) {
-    scene()->removeItem(trail);
-    delete trail;
+void Body::ClearTrail() {
+  trail_head_ = 0;
+  trail_size_ = 0;
+}
+
+int Body::GetTrailSize() const {
+  return trail_size_;
+}
+
+QPointF Body::GetTrailPoint(int index) const {
+  return trail_[(trail_head_ - trail_size_ + index + trail_length_) %
+                trail_length_];
+}
+
+quint64 Body::GetStateHash() const {
+  const qreal values[] = {mass_, radius_, position_.x(), position_.y(),
+                          velocity_.x(), velocity_.y()};
+  unsigned char bytes[sizeof(id_) + sizeof(values)];
+  memcpy(bytes, &id_, sizeof(id_));
+  memcpy(bytes + sizeof(id_), values, sizeof(values));
+  // 64-bit FNV-1a.
+  quint64 hash = 14695981039346656037ULL;
+  for (unsigned i = 0; i < sizeof(bytes); ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
   }
-  trails_.clear();
+  return hash;
+}
+
+void *Body::operator new(size_t size) {
+  if (size != sizeof(Body))
+    return ::operator new(size);
+  return Pool().Allocate();
+}
+
+void Body::operator delete(void *body, size_t size) {
+  if (size != sizeof(Body))
+    ::operator delete(body);
+  else
+    Pool().Free(body);
+}
+
+qint64 Body::GetPooledBytes() const {
+  return static_cast<qint64>(Pool().GetObjectSize()) +
+         (trail_pool_ != NULL ? trail_pool_->GetObjectSize() : 0);
+}
+
+qint64 Body::GetReservedBytes() {
+  qint64 bytes = Pool().GetReservedBytes();
+  TrailPools &trail_pools = GetTrailPools();
+  std::lock_guard<std::mutex> lock(trail_pools.mutex);
+  for (const auto &pool : trail_pools.pools)
+    bytes += pool.second->GetReservedBytes();
+  return bytes;
 }
@@ -30,15 +30,20 @@
 #ifndef BODY_H
 #define BODY_H
 
-#include <QGraphicsEllipseItem>
+#include <QColor>
+#include <QList>
+#include <QPointF>
+
+#include "object_pool.h"
 
 /**
-  * @brief Planet-like object floating in space.
+  * @brief Planet-like object floating in space. Bodies are not items of
+  *        Scene themselves, they are drawn all at once by BodiesItem.
   */
-class Body : public QGraphicsEllipseItem {
+class Body {
  public:
-  // Number of lines which together create trail behind Body.
-  static constexpr int kTrailCount = 25;
+  // Default number of positions which together create trail behind Body.
+  static constexpr int kDefaultTrailLength = 25;
 
   /**
     * @brief Body constructor.
@@ -63,10 +68,22 @@ class Body : public QGraphicsEllipseItem {
       : Body(mass, radius, QPointF(vel_x, vel_y), QPointF(pos_x, pos_y)) {}
 
   /**
-    * @brief Body destructor.
+    * @brief Body destructor. Returns trail to its pool.
     */
   ~Body();
 
+  /**
+    * @brief  Identifier accessor.
+    * @retval Number which identifies Body for its whole life.
+    */
+  quint32 GetId() const;
+
+  /**
+    * @brief Identifier mutator.
+    * @param id Number which identifies Body for its whole life.
+    */
+  void SetId(quint32 id);
+
   /**
     * @brief  Radius accessor.
     * @retval Radius of Body.
@@ -91,6 +108,39 @@ class Body : public QGraphicsEllipseItem {
     */
   void SetMass(qreal mass);
 
+  /**
+    * @brief  Test particle accessor.
+    * @retval Is Body pulled by others without pulling them?
+    */
+  bool IsTestParticle() const;
+
+  /**
+    * @brief Test particle mutator. Test particles do not pull each other,
+    *        so they cost much less than other Bodies.
+    * @param test_particle Should Body be pulled by others without pulling
+    *        them?
+    */
+  void SetTestParticle(bool test_particle);
+
+  /**
+    * @brief  Finds colour of Body with given mass.
+    * @param  mass Mass of Body.
+    * @retval Colour of Body.
+    */
+  static QColor ColorOfMass(qreal mass);
+
+  /**
+    * @brief  Position accessor.
+    * @retval Position of Body in Scene.
+    */
+  QPointF GetPosition() const;
+
+  /**
+    * @brief Position mutator.
+    * @param position New position of Body in Scene.
+    */
+  void SetPosition(QPointF position);
+
   /**
     * @brief  Velocity accessor.
     * @retval Velocity of Body.
@@ -111,35 +161,92 @@ class Body : public QGraphicsEllipseItem {
   void SetVelocity(qreal vel_x, qreal vel_y);
 
   /**
-    * @brief Creates trails behind Body.
-    * @param view_scale Current zoom of View.
+    * @brief Changes number of remembered positions. The most recent ones are
+    *        kept. Length of 0 frees memory used by trail.
+    * @param length New length of trail.
+    */
+  void SetTrailLength(int length);
+
+  /**
+    * @brief Appends current position to trail, overwriting the oldest one
+    *        if trail is full.
+    */
+  void RecordTrail();
+
+  /**
+    * @brief Forgets all remembered positions.
+    */
+  void ClearTrail();
+
+  /**
+    * @brief  Trail size accessor.
+    * @retval Number of remembered positions.
+    */
+  int GetTrailSize() const;
+
+  /**
+    * @brief  Trail accessor.
+    * @param  index Index of position, 0 is the oldest one.
+    * @retval Remembered position.
+    */
+  QPointF GetTrailPoint(int index) const;
+
+  /**
+    * @brief  Finds hash of identifier, mass, radius, position and velocity.
+    *         Equal only if state of Bodies is equal bit by bit.
+    * @retval Hash of state of Body.
+    */
+  quint64 GetStateHash() const;
+
+  /**
+    * @brief  Takes memory for Body from pool shared by all Bodies, so
+    *         merging and removing Bodies does not fragment heap. Objects of
+    *         derived classes are bigger and get memory from heap.
+    * @param  size Size of object.
+    * @retval Memory for object.
+    */
+  static void *operator new(size_t size);
+
+  /**
+    * @brief Returns memory of object to pool or heap it was taken from.
+    * @param body Memory of object.
+    * @param size Size of object.
+    */
+  static void operator delete(void *body, size_t size);
+
+  /**
+    * @brief  Finds memory taken from pools by Body and its trail.
+    * @retval Size of pooled memory of Body and its trail [B].
     */
-  void CreateTrails(qreal view_scale);
+  qint64 GetPooledBytes() const;
 
   /**
-    * @brief Removes trails behind Body.
+    * @brief  Finds memory reserved by pools of all Bodies and trails in
+    *         process, including free slots.
+    * @retval Size of all pools [B].
     */
-  void DeleteTrails();
+  static qint64 GetReservedBytes();
 
   // List of Bodies which are colliding with this Body.
   QList<Body*> colliding_with_;
-  QList<QGraphicsLineItem*> trails_;
-  int trail_iterator_;
-  QPointF last_position_;
-  // Increments used in Runge-Kutta method.
-  QPointF k1dx_;
-  QPointF k1dv_;
-  QPointF k2dx_;
-  QPointF k2dv_;
-  QPointF k3dx_;
-  QPointF k3dv_;
-  QPointF k4dx_;
-  QPointF k4dv_;
 
  private:
+  quint32 id_;
   qreal radius_;
   qreal mass_;
+  bool test_particle_;
+  QPointF position_;
   QPointF velocity_;
+  // Ring buffer of recent positions.
+  QPointF *trail_;
+  int trail_length_;
+  // Pool of trails of trail_length_ which trail_ is taken from.
+  ObjectPool *trail_pool_;
+  // Index at which next position will be stored.
+  int trail_head_;
+  int trail_size_;
+
+  Q_DISABLE_COPY(Body)
 };
 
 #endif // BODY_H
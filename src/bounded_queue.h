@@ -0,0 +1,108 @@
+/**
+  ******************************************************************************
+  * @file    bounded_queue.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of BoundedQueue class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/**
+  * @brief First in, first out queue shared between threads. Producer waits
+  *        when queue is full and consumer waits when it is empty.
+  */
+template <typename T>
+class BoundedQueue {
+ public:
+  /**
+    * @brief BoundedQueue constructor.
+    * @param capacity Maximum number of queued items.
+    */
+  explicit BoundedQueue(int capacity)
+      : capacity_(capacity),
+        closed_(false) {
+  }
+
+  /**
+    * @brief  Appends item, waiting until there is room for it.
+    * @param  item Appended item.
+    * @retval False if queue was closed and item was dropped.
+    */
+  bool Push(const T &item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_full_.wait(lock, [this] {
+      return closed_ || static_cast<int>(items_.size()) < capacity_;
+    });
+    if (closed_)
+      return false;
+    items_.push_back(item);
+    not_empty_.notify_one();
+    return true;
+  }
+
+  /**
+    * @brief  Removes the oldest item, waiting until there is one.
+    * @param  item Removed item.
+    * @retval False if queue was closed and all items were already removed.
+    */
+  bool Pop(T *item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+    if (items_.empty())
+      return false;
+    *item = items_.front();
+    items_.pop_front();
+    not_full_.notify_one();
+    return true;
+  }
+
+  /**
+    * @brief Wakes all waiting threads. Queued items can still be removed,
+    *        but no new ones are accepted.
+    */
+  void Close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closed_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  const int capacity_;
+  std::deque<T> items_;
+  std::mutex mutex_;
+  // Wakes producers when item was removed.
+  std::condition_variable not_full_;
+  // Wakes consumers when item was appended.
+  std::condition_variable not_empty_;
+  bool closed_;
+};
+
+#endif // BOUNDED_QUEUE_H
@@ -0,0 +1,92 @@
+/**
+  ******************************************************************************
+  * @file    cpu_features.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   CPU feature functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "cpu_features.h"
+
+/**
+  * @brief  Asks processor which instruction sets it supports.
+  * @retval The newest supported instruction set.
+  */
+static InstructionSet DetectInstructionSet() {
+#ifdef HAVE_ISA_DISPATCH
+  // Compiler runtime also checks that operating system saves wide
+  // registers.
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512cd") &&
+      __builtin_cpu_supports("avx512vl") &&
+      __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq"))
+    return kAvx512;
+  if (__builtin_cpu_supports("avx2"))
+    return kAvx2;
+#endif
+  return kBaseline;
+}
+
+// Detected before main, so threads started later only read it.
+static const InstructionSet supported_instruction_set = DetectInstructionSet();
+static InstructionSet instruction_set = supported_instruction_set;
+
+InstructionSet GetSupportedInstructionSet() {
+  return supported_instruction_set;
+}
+
+InstructionSet GetInstructionSet() {
+  return instruction_set;
+}
+
+bool SetInstructionSet(InstructionSet new_instruction_set) {
+  if (new_instruction_set > supported_instruction_set)
+    return false;
+  instruction_set = new_instruction_set;
+  return true;
+}
+
+QString NameOfInstructionSet(InstructionSet instruction_set) {
+  switch (instruction_set) {
+    case kAvx2:
+      return "avx2";
+    case kAvx512:
+      return "avx512";
+    default:
+      return "baseline";
+  }
+}
+
+bool InstructionSetOfName(const QString &name,
+                          InstructionSet *instruction_set) {
+  if (name == "baseline")
+    *instruction_set = kBaseline;
+  else if (name == "avx2")
+    *instruction_set = kAvx2;
+  else if (name == "avx512")
+    *instruction_set = kAvx512;
+  else
+    return false;
+  return true;
+}
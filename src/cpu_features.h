@@ -0,0 +1,99 @@
+/**
+  ******************************************************************************
+  * @file    cpu_features.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of CPU feature functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <QString>
+
+// Hot kernels are compiled for several instruction sets of x86 processors
+// and one of them is chosen at startup. Fused multiply-add is left out, so
+// results are the same on every processor.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAVE_ISA_DISPATCH
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 \
+    __attribute__((target("avx512f,avx512cd,avx512vl,avx512bw,avx512dq")))
+#endif
+
+// Body of kernel is inlined into each variant, so it is compiled for
+// instruction set of the variant.
+#if defined(__GNUC__) || defined(__clang__)
+#define ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define ALWAYS_INLINE inline
+#endif
+
+/**
+  * @brief Instruction sets for which kernels are compiled, from the oldest.
+  */
+enum InstructionSet {
+  kBaseline,
+  kAvx2,
+  kAvx512
+};
+
+/**
+  * @brief  Finds the newest instruction set supported by processor and
+  *         operating system. It is checked once, with CPUID.
+  * @retval Supported instruction set.
+  */
+InstructionSet GetSupportedInstructionSet();
+
+/**
+  * @brief  Instruction set accessor.
+  * @retval Instruction set of kernels created from now on.
+  */
+InstructionSet GetInstructionSet();
+
+/**
+  * @brief  Instruction set mutator. Meant for startup, before any kernel
+  *         is chosen, e.g. to compare speed of older kernels.
+  * @param  instruction_set Instruction set of kernels.
+  * @retval Is instruction set supported?
+  */
+bool SetInstructionSet(InstructionSet instruction_set);
+
+/**
+  * @brief  Names instruction set.
+  * @param  instruction_set Instruction set.
+  * @retval Name: baseline, avx2 or avx512.
+  */
+QString NameOfInstructionSet(InstructionSet instruction_set);
+
+/**
+  * @brief  Finds instruction set by its name.
+  * @param  name Name: baseline, avx2 or avx512.
+  * @param  instruction_set Found instruction set.
+  * @retval Is name known?
+  */
+bool InstructionSetOfName(const QString &name,
+                          InstructionSet *instruction_set);
+
+#endif // CPU_FEATURES_H
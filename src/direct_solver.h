@@ -0,0 +1,125 @@
+/**
+  ******************************************************************************
+  * @file    direct_solver.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of DirectSolver class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef DIRECT_SOLVER_H
+#define DIRECT_SOLVER_H
+
+#include <QPointF>
+#include <QVector>
+#include <algorithm>
+
+#include "gravity_kernel.h"
+#include "softening_kernels.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Force policy which sums gravitational pull of every pair of
+  *        Bodies directly. Forces are summed in Scalar, results are double.
+  *        Bodies are split into blocks of fixed size summed in parallel.
+  *        Each sum is made whole in one block, so results are the same for
+  *        any number of threads. Kernel shapes gravity at short distances.
+  */
+template <typename Scalar, template <typename> class Kernel = CutoffKernel>
+class DirectSolver {
+ public:
+  // Number of Bodies pulled in one task.
+  static constexpr int kBlockSize = 64;
+
+  /**
+    * @brief DirectSolver constructor.
+    * @param grav_constant Gravitational constant.
+    * @param softening_length Softening length of Kernel.
+    * @param pool Threads which sum forces.
+    */
+  DirectSolver(qreal grav_constant, qreal softening_length, WorkerPool *pool)
+      : grav_constant_(grav_constant),
+        kernel_(softening_length),
+        pool_(pool),
+        sum_(SelectSumAccelerations<Scalar, Kernel<Scalar> >()) {}
+
+  /**
+    * @brief  Gravitational constant accessor.
+    * @retval Gravitational constant.
+    */
+  qreal GetGravConstant() const {
+    return grav_constant_;
+  }
+
+  /**
+    * @brief Ids mutator. Forces are summed anew every time, so ids are not
+    *        used.
+    * @param ids Ids of Bodies.
+    */
+  void SetIds(const QVector<quint32> &ids) {
+    Q_UNUSED(ids);
+  }
+
+  /**
+    * @brief Finds gravitational acceleration of every Body.
+    * @param positions Positions of Bodies.
+    * @param masses Masses of Bodies. Bodies with mass 0 are only pulled, so
+    *        cost is proportional to their number times number of others.
+    * @param accelerations Accelerations of Bodies.
+    */
+  void Accelerate(const QVector<QPointF> &positions,
+                  const QVector<qreal> &masses,
+                  QVector<QPointF> *accelerations) {
+    arrays_.Gather(positions, masses, kBlockSize, pool_);
+    const int count = positions.size();
+    accelerations->resize(count);
+    QPointF *result = accelerations->data();
+    const int block_count = (count + kBlockSize - 1) / kBlockSize;
+    pool_->Run(block_count, [&](int block, int) {
+      const int begin = block * kBlockSize;
+      const int end = std::min(begin + kBlockSize, count);
+      sum_(arrays_, kernel_, begin, end, result);
+      for (int i = begin; i < end; ++i)
+        result[i] *= grav_constant_;
+    });
+  }
+
+  /**
+    * @brief Adds bytes of arrays summed in parallel to NUMA nodes where
+    *        they are.
+    * @param node_bytes Bytes on each node.
+    */
+  void CountNodeBytes(QVector<qint64> *node_bytes) const {
+    arrays_.CountNodeBytes(node_bytes);
+  }
+
+ private:
+  qreal grav_constant_;
+  Kernel<Scalar> kernel_;
+  WorkerPool *pool_;
+  // SumAccelerations compiled for instruction set of processor.
+  SumFunction<Scalar, Kernel<Scalar> > sum_;
+  // Copies of positions and masses in Scalar, reused between calls.
+  BodyArrays<Scalar> arrays_;
+};
+
+#endif // DIRECT_SOLVER_H
@@ -0,0 +1,538 @@
+/**
+  ******************************************************************************
+  * @file    distributed_runner.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   DistributedRunner class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "distributed_runner.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mpi.h>
+
+#include "cpu_features.h"
+#include "distributed_solver.h"
+#include "euler_integrator.h"
+#include "hilbert_curve.h"
+#include "mpi_exchange.h"
+#include "presets.h"
+#include "runge_kutta_integrator.h"
+#include "simulation.h"
+#include "softening_kernels.h"
+
+// Number of doubles sent for moved Body: id, position, velocity, mass,
+// radius and test particle flag.
+const int kBodyRecordSize = 8;
+// Number of doubles sent for copy of Body: id, position and radius.
+const int kGhostRecordSize = 4;
+// Number of doubles in summary of process. The last one is instruction set
+// of kernels, as processes may run on different machines.
+const int kSummarySize = 7;
+
+/**
+  * @brief  Creates Stepper with given integration policy and forces summed
+  *         with locally essential trees in Scalar.
+  * @param  softening Shape of gravity at short distances.
+  * @param  softening_length Softening length of Plummer and spline kernels.
+  * @param  pool Threads which sum forces.
+  * @retval New Stepper.
+  */
+template <template <class> class Integrator, typename Scalar>
+static Stepper *CreateStepper(Simulation::Softening softening,
+                              qreal softening_length, WorkerPool *pool) {
+  switch (softening) {
+    case Simulation::kPlummer:
+      return new PolicyStepper<Integrator,
+                               DistributedSolver<Scalar, PlummerKernel> >(
+          Simulation::kGravConstant, softening_length, pool);
+    case Simulation::kSpline:
+      return new PolicyStepper<Integrator,
+                               DistributedSolver<Scalar, SplineKernel> >(
+          Simulation::kGravConstant, softening_length, pool);
+    default:
+      return new PolicyStepper<Integrator,
+                               DistributedSolver<Scalar, CutoffKernel> >(
+          Simulation::kGravConstant, Simulation::kMinDistance, pool);
+  }
+}
+
+/**
+  * @brief  Creates Stepper with given integration policy.
+  * @param  single_precision Are forces summed in single precision?
+  * @param  softening Shape of gravity at short distances.
+  * @param  softening_length Softening length of Plummer and spline kernels.
+  * @param  pool Threads which sum forces.
+  * @retval New Stepper.
+  */
+template <template <class> class Integrator>
+static Stepper *CreateStepper(bool single_precision,
+                              Simulation::Softening softening,
+                              qreal softening_length, WorkerPool *pool) {
+  if (single_precision)
+    return CreateStepper<Integrator, float>(softening, softening_length, pool);
+  return CreateStepper<Integrator, double>(softening, softening_length, pool);
+}
+
+DistributedRunner::DistributedRunner(int thread_count)
+    : pool_(new WorkerPool(thread_count)),
+      stepper_(NULL),
+      time_step_(0.0),
+      step_(0),
+      balanced_seconds_(0.0),
+      seconds_(0.0) {
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+  MPI_Comm_size(MPI_COMM_WORLD, &process_count_);
+}
+
+DistributedRunner::~DistributedRunner() {
+  delete stepper_;
+  delete pool_;
+}
+
+void DistributedRunner::Run(const EnsembleRunner::Scenario &scenario) {
+  time_step_ = scenario.time_step;
+  delete stepper_;
+  if (scenario.method == Simulation::kRungeKutta) {
+    stepper_ = CreateStepper<RungeKuttaIntegrator>(
+        scenario.single_precision, scenario.softening,
+        scenario.softening_length, pool_);
+  } else {
+    stepper_ = CreateStepper<EulerIntegrator>(
+        scenario.single_precision, scenario.softening,
+        scenario.softening_length, pool_);
+  }
+  // Every process creates the same Bodies from the same seed.
+  qsrand(scenario.seed);
+  if (scenario.preset == "solar")
+    AddBodies(CreateSolarSystem(scenario.perturbation));
+  else
+    AddBodies(CreateProtodisk(scenario.bodies, scenario.test_particles));
+
+  QElapsedTimer timer;
+  timer.start();
+  step_ = 0;
+  for (int i = 0; i < scenario.steps; ++i)
+    Step();
+  seconds_ = timer.nsecsElapsed() * 1e-9;
+}
+
+bool DistributedRunner::Save(const QString &path) {
+  double summary[kSummarySize] = {static_cast<double>(ids_.size()), 0.0,
+                                  0.0, 0.0, pool_->GetBusySeconds(),
+                                  seconds_,
+                                  static_cast<double>(GetInstructionSet())};
+  for (int i = 0; i < ids_.size(); ++i) {
+    summary[1] += masses_.at(i);
+    summary[2] += masses_.at(i) * velocities_.at(i).x();
+    summary[3] += masses_.at(i) * velocities_.at(i).y();
+  }
+  QVector<double> summaries(kSummarySize * process_count_);
+  MPI_Gather(summary, kSummarySize, MPI_DOUBLE, summaries.data(),
+             kSummarySize, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  int written = 1;
+  if (rank_ == 0) {
+    QFile file(path);
+    written = file.open(QIODevice::WriteOnly | QIODevice::Text) ? 1 : 0;
+    if (written != 0) {
+      QTextStream out(&file);
+      out.setRealNumberPrecision(12);
+      out << "rank,bodies,mass,momentum_x,momentum_y,force_seconds,"
+             "seconds,kernels\n";
+      for (int r = 0; r < process_count_; ++r) {
+        const double *values = summaries.constData() + kSummarySize * r;
+        out << r;
+        for (int k = 0; k < kSummarySize - 1; ++k)
+          out << "," << values[k];
+        out << "," << NameOfInstructionSet(static_cast<InstructionSet>(
+                          static_cast<int>(values[kSummarySize - 1])))
+            << "\n";
+      }
+      out.flush();
+      written = file.error() == QFile::NoError ? 1 : 0;
+    }
+  }
+  // Every process returns the same result.
+  MPI_Bcast(&written, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return written != 0;
+}
+
+void DistributedRunner::AddBodies(const QList<Body*> &bodies) {
+  for (int i = 0; i < bodies.count(); ++i) {
+    Body *body = bodies.at(i);
+    if (i % process_count_ == rank_) {
+      ids_.append(i + 1);
+      positions_.append(body->GetPosition());
+      velocities_.append(body->GetVelocity());
+      masses_.append(body->GetMass());
+      radii_.append(body->GetRadius());
+      test_particles_.append(body->IsTestParticle());
+    }
+    delete body;
+  }
+}
+
+void DistributedRunner::Balance() {
+  const int count = ids_.size();
+  // Curve fills bounding square of all Bodies. Maxima are negated, so all
+  // bounds are found by one reduction.
+  double bounds[4];
+  std::fill(bounds, bounds + 4, std::numeric_limits<double>::max());
+  for (int i = 0; i < count; ++i) {
+    const QPointF &position = positions_.at(i);
+    bounds[0] = std::min(bounds[0], position.x());
+    bounds[1] = std::min(bounds[1], position.y());
+    bounds[2] = std::min(bounds[2], -position.x());
+    bounds[3] = std::min(bounds[3], -position.y());
+  }
+  MPI_Allreduce(MPI_IN_PLACE, bounds, 4, MPI_DOUBLE, MPI_MIN,
+                MPI_COMM_WORLD);
+  const qreal size = std::max(-bounds[2] - bounds[0], -bounds[3] - bounds[1]);
+  const qreal scale = size > 0.0 ? ((1 << kHilbertOrder) - 1) / size : 0.0;
+
+  // Bodies share work of their process equally. Before first measurement
+  // every Body costs the same.
+  const double busy_seconds = pool_->GetBusySeconds();
+  double cost = 1.0;
+  if (count > 0 && busy_seconds > balanced_seconds_)
+    cost = (busy_seconds - balanced_seconds_) / count;
+  balanced_seconds_ = busy_seconds;
+  // Bodies are ordered along curve, ties by id, the same in every process.
+  QVector<std::pair<double, double> > places(count);
+  QVector<int> local_order(count);
+  for (int i = 0; i < count; ++i) {
+    const QPointF &position = positions_.at(i);
+    const quint32 column =
+        static_cast<quint32>((position.x() - bounds[0]) * scale);
+    const quint32 row =
+        static_cast<quint32>((position.y() - bounds[1]) * scale);
+    places[i] = std::make_pair(HilbertIndex(column, row), ids_.at(i));
+    local_order[i] = i;
+  }
+  std::sort(local_order.begin(), local_order.end(), [&](int a, int b) {
+    return places.at(a) < places.at(b);
+  });
+
+  // Every process sends Bodies in the middle of equal shares of its cost,
+  // each with that share. Process without Bodies sends zero costs.
+  QVector<double> samples(3 * kBalanceSamples, 0.0);
+  for (int k = 0; k < kBalanceSamples && count > 0; ++k) {
+    const int i = local_order.at(
+        (2 * static_cast<qint64>(k) + 1) * count / (2 * kBalanceSamples));
+    samples[3 * k] = places.at(i).first;
+    samples[3 * k + 1] = places.at(i).second;
+    samples[3 * k + 2] = cost * count / kBalanceSamples;
+  }
+  QVector<double> all(3 * kBalanceSamples * process_count_);
+  MPI_Allgather(samples.data(), samples.size(), MPI_DOUBLE, all.data(),
+                samples.size(), MPI_DOUBLE, MPI_COMM_WORLD);
+
+  QVector<std::pair<double, double> > curve(all.size() / 3);
+  QVector<double> costs(all.size() / 3);
+  double total_cost = 0.0;
+  QVector<int> order(curve.size());
+  for (int i = 0; i < curve.size(); ++i) {
+    curve[i] = std::make_pair(all.at(3 * i), all.at(3 * i + 1));
+    costs[i] = all.at(3 * i + 2);
+    total_cost += costs.at(i);
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return curve.at(a) < curve.at(b);
+  });
+  // Segment of each next process starts where cost so far reaches its
+  // share.
+  QVector<std::pair<double, double> > splitters;
+  double sum = 0.0;
+  for (int k = 0; k < order.size(); ++k) {
+    while (splitters.size() + 1 < process_count_ &&
+           sum >= (splitters.size() + 1) * total_cost / process_count_)
+      splitters.append(curve.at(order.at(k)));
+    sum += costs.at(order.at(k));
+  }
+  while (splitters.size() + 1 < process_count_) {
+    splitters.append(std::make_pair(std::numeric_limits<double>::max(),
+                                    std::numeric_limits<double>::max()));
+  }
+
+  QVector<int> targets(count);
+  for (int i = 0; i < count; ++i) {
+    targets[i] = std::upper_bound(splitters.begin(), splitters.end(),
+                                  places.at(i)) - splitters.begin();
+  }
+  Migrate(targets);
+}
+
+void DistributedRunner::Migrate(const QVector<int> &targets) {
+  QVector<QVector<double> > outgoing(process_count_);
+  int kept = 0;
+  for (int i = 0; i < ids_.size(); ++i) {
+    const int target = targets.at(i);
+    if (target == rank_) {
+      ids_[kept] = ids_.at(i);
+      positions_[kept] = positions_.at(i);
+      velocities_[kept] = velocities_.at(i);
+      masses_[kept] = masses_.at(i);
+      radii_[kept] = radii_.at(i);
+      test_particles_[kept] = test_particles_.at(i);
+      ++kept;
+    } else if (target >= 0) {
+      QVector<double> &record = outgoing[target];
+      record.append(ids_.at(i));
+      record.append(positions_.at(i).x());
+      record.append(positions_.at(i).y());
+      record.append(velocities_.at(i).x());
+      record.append(velocities_.at(i).y());
+      record.append(masses_.at(i));
+      record.append(radii_.at(i));
+      record.append(test_particles_.at(i) ? 1.0 : 0.0);
+    }
+  }
+  ids_.resize(kept);
+  positions_.resize(kept);
+  velocities_.resize(kept);
+  masses_.resize(kept);
+  radii_.resize(kept);
+  test_particles_.resize(kept);
+
+  QVector<double> incoming;
+  ExchangeRecords(outgoing, &incoming);
+  for (int i = 0; i + kBodyRecordSize <= incoming.size();
+       i += kBodyRecordSize) {
+    const double *record = incoming.constData() + i;
+    ids_.append(static_cast<quint32>(record[0]));
+    positions_.append(QPointF(record[1], record[2]));
+    velocities_.append(QPointF(record[3], record[4]));
+    masses_.append(record[5]);
+    radii_.append(record[6]);
+    test_particles_.append(record[7] != 0.0);
+  }
+}
+
+void DistributedRunner::FindCollisions() {
+  const int count = ids_.size();
+  // Bounding rectangle of own Bodies and their largest radius. Empty
+  // rectangle has left edge on the right.
+  double box[5] = {std::numeric_limits<double>::max(),
+                   std::numeric_limits<double>::max(),
+                   -std::numeric_limits<double>::max(),
+                   -std::numeric_limits<double>::max(), 0.0};
+  for (int i = 0; i < count; ++i) {
+    box[0] = std::min(box[0], positions_.at(i).x());
+    box[1] = std::min(box[1], positions_.at(i).y());
+    box[2] = std::max(box[2], positions_.at(i).x());
+    box[3] = std::max(box[3], positions_.at(i).y());
+    box[4] = std::max(box[4], radii_.at(i));
+  }
+  QVector<double> boxes(5 * process_count_);
+  MPI_Allgather(box, 5, MPI_DOUBLE, boxes.data(), 5, MPI_DOUBLE,
+                MPI_COMM_WORLD);
+  qreal max_radius = 0.0;
+  for (int r = 0; r < process_count_; ++r)
+    max_radius = std::max(max_radius, boxes.at(5 * r + 4));
+
+  // Body can touch Bodies of other process only if it is closer to their
+  // rectangle than its radius and the largest one.
+  QVector<QVector<double> > outgoing(process_count_);
+  for (int r = 0; r < process_count_; ++r) {
+    const double *other = boxes.constData() + 5 * r;
+    if (r == rank_ || other[0] > other[2])
+      continue;
+    for (int i = 0; i < count; ++i) {
+      const QPointF &position = positions_.at(i);
+      const qreal delta_x = std::max(std::max(other[0] - position.x(),
+                                              position.x() - other[2]), 0.0);
+      const qreal delta_y = std::max(std::max(other[1] - position.y(),
+                                              position.y() - other[3]), 0.0);
+      const qreal reach = radii_.at(i) + max_radius;
+      if (delta_x * delta_x + delta_y * delta_y <= reach * reach) {
+        outgoing[r].append(ids_.at(i));
+        outgoing[r].append(position.x());
+        outgoing[r].append(position.y());
+        outgoing[r].append(radii_.at(i));
+      }
+    }
+  }
+  QVector<double> incoming;
+  QVector<int> incoming_counts;
+  ExchangeRecords(outgoing, &incoming, &incoming_counts);
+  ghost_ids_.clear();
+  ghost_positions_.clear();
+  ghost_radii_.clear();
+  ghost_ranks_.clear();
+  int offset = 0;
+  for (int r = 0; r < process_count_; ++r) {
+    for (int i = 0; i < incoming_counts.at(r); i += kGhostRecordSize) {
+      const double *record = incoming.constData() + offset + i;
+      ghost_ids_.append(static_cast<quint32>(record[0]));
+      ghost_positions_.append(QPointF(record[1], record[2]));
+      ghost_radii_.append(record[3]);
+      ghost_ranks_.append(r);
+    }
+    offset += incoming_counts.at(r);
+  }
+
+  // Own Bodies and copies are swept together, sorted by left edge.
+  const int total = count + ghost_ids_.size();
+  auto position_of = [&](int i) {
+    return i < count ? positions_.at(i) : ghost_positions_.at(i - count);
+  };
+  auto radius_of = [&](int i) {
+    return i < count ? radii_.at(i) : ghost_radii_.at(i - count);
+  };
+  QVector<int> order(total);
+  for (int i = 0; i < total; ++i)
+    order[i] = i;
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    return position_of(a).x() - radius_of(a) <
+           position_of(b).x() - radius_of(b);
+  });
+  pairs_.clear();
+  for (int k = 0; k < total; ++k) {
+    const int a = order.at(k);
+    const QPointF position = position_of(a);
+    const qreal right = position.x() + radius_of(a);
+    for (int l = k + 1; l < total; ++l) {
+      const int b = order.at(l);
+      if (position_of(b).x() - radius_of(b) > right)
+        break;
+      // Copies collide with each other in their own processes.
+      if (a >= count && b >= count)
+        continue;
+      const QPointF delta = position_of(b) - position;
+      const qreal reach = radius_of(a) + radius_of(b);
+      if (delta.x() * delta.x() + delta.y() * delta.y() <= reach * reach)
+        pairs_.append(std::make_pair(std::min(a, b), std::max(a, b)));
+    }
+  }
+}
+
+int DistributedRunner::FindGroup(int body) {
+  while (groups_.at(body) != body) {
+    groups_[body] = groups_.at(groups_.at(body));
+    body = groups_.at(body);
+  }
+  return body;
+}
+
+void DistributedRunner::ResolveCollisions() {
+  const int count = ids_.size();
+  QVector<int> targets(count, rank_);
+  if (pairs_.isEmpty()) {
+    Migrate(targets);
+    return;
+  }
+  const int total = count + ghost_ids_.size();
+  auto id_of = [&](int i) {
+    return i < count ? ids_.at(i) : ghost_ids_.at(i - count);
+  };
+  groups_.resize(total);
+  for (int i = 0; i < total; ++i)
+    groups_[i] = i;
+  for (int p = 0; p < pairs_.size(); ++p) {
+    const int group_1 = FindGroup(pairs_.at(p).first);
+    const int group_2 = FindGroup(pairs_.at(p).second);
+    groups_[std::max(group_1, group_2)] = std::min(group_1, group_2);
+  }
+  // Member with the lowest id of every group, indexed by its root.
+  QVector<int> lowest(total, -1);
+  QVector<int> members;
+  for (int p = 0; p < pairs_.size(); ++p) {
+    const int ends[2] = {pairs_.at(p).first, pairs_.at(p).second};
+    for (int e = 0; e < 2; ++e) {
+      const int root = FindGroup(ends[e]);
+      if (lowest.at(root) < 0 || id_of(ends[e]) < id_of(lowest.at(root)))
+        lowest[root] = ends[e];
+      if (ends[e] < count)
+        members.append(ends[e]);
+    }
+  }
+  // Own members are merged by groups in order of ids, so results do not
+  // depend on order of Bodies.
+  std::sort(members.begin(), members.end(), [&](int a, int b) {
+    const int group_a = FindGroup(a);
+    const int group_b = FindGroup(b);
+    return group_a != group_b ? group_a < group_b : ids_.at(a) < ids_.at(b);
+  });
+  members.erase(std::unique(members.begin(), members.end()), members.end());
+
+  for (int begin = 0; begin < members.size();) {
+    const int root = FindGroup(members.at(begin));
+    int end = begin + 1;
+    while (end < members.size() && FindGroup(members.at(end)) == root)
+      ++end;
+    const int survivor = lowest.at(root);
+    if (survivor >= count) {
+      // Group is merged by process owning its lowest id.
+      for (int m = begin; m < end; ++m)
+        targets[members.at(m)] = ghost_ranks_.at(survivor - count);
+    } else if (end - begin > 1) {
+      qreal mass = 0.0;
+      qreal volume = 0.0;
+      QPointF momentum(0.0, 0.0);
+      QPointF mass_center(0.0, 0.0);
+      bool test_particle = true;
+      for (int m = begin; m < end; ++m)
+        test_particle &= test_particles_.at(members.at(m));
+      for (int m = begin; m < end; ++m) {
+        const int body = members.at(m);
+        if (body != survivor)
+          targets[body] = -1;
+        // Test particles absorbed by regular Bodies add nothing to them.
+        if (!test_particle && test_particles_.at(body))
+          continue;
+        mass += masses_.at(body);
+        volume += pow(radii_.at(body), 3);
+        momentum += velocities_.at(body) * masses_.at(body);
+        mass_center += positions_.at(body) * masses_.at(body);
+      }
+      masses_[survivor] = mass;
+      radii_[survivor] = cbrt(volume);
+      velocities_[survivor] = momentum / mass;
+      positions_[survivor] = mass_center / mass;
+      test_particles_[survivor] = test_particle;
+    }
+    begin = end;
+  }
+  Migrate(targets);
+}
+
+void DistributedRunner::Step() {
+  if (step_ % kBalanceInterval == 0)
+    Balance();
+  // Collisions are found at positions from beginning of step.
+  FindCollisions();
+  const int count = ids_.size();
+  source_masses_.resize(count);
+  for (int i = 0; i < count; ++i)
+    source_masses_[i] = test_particles_.at(i) ? 0.0 : masses_.at(i);
+  stepper_->SetIds(ids_);
+  stepper_->Advance(time_step_, source_masses_, &positions_, &velocities_);
+  ResolveCollisions();
+  ++step_;
+}
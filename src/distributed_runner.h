@@ -0,0 +1,172 @@
+/**
+  ******************************************************************************
+  * @file    distributed_runner.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of DistributedRunner class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef DISTRIBUTED_RUNNER_H
+#define DISTRIBUTED_RUNNER_H
+
+#include <QList>
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include <utility>
+
+#include "body.h"
+#include "ensemble_runner.h"
+#include "stepper.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Runs one large simulation split between MPI processes, possibly
+  *        on many machines. Every process owns Bodies of one segment of
+  *        Hilbert curve over all Bodies. Segments are rebalanced
+  *        periodically by measured cost of forces, so dense parts of
+  *        evolving disk get smaller segments. Forces are summed with
+  *        locally essential trees. Collisions across segments are found
+  *        with copies of Bodies near other segments; Body touching one with
+  *        lower id from other process moves there and merges on next step.
+  */
+class DistributedRunner {
+ public:
+  // Number of steps between balancing of segments.
+  static constexpr int kBalanceInterval = 64;
+  // Number of Bodies of each process which segments are split by. Each one
+  // stands for equal share of cost of its process.
+  static constexpr int kBalanceSamples = 256;
+
+  /**
+    * @brief DistributedRunner constructor. MPI has to be initialized.
+    * @param thread_count Number of threads of this process summing forces.
+    *        Value 0 means number of processor cores.
+    */
+  explicit DistributedRunner(int thread_count);
+
+  /**
+    * @brief DistributedRunner destructor.
+    */
+  ~DistributedRunner();
+
+  /**
+    * @brief Runs scenario. Has to be called by all processes with the same
+    *        scenario.
+    * @param scenario Parameters of simulation. Only Euler and Runge-Kutta
+    *        methods are supported, as adaptive and Wisdom-Holman methods
+    *        need all Bodies. Forces are always summed with tree and tight
+    *        pairs are not integrated separately.
+    */
+  void Run(const EnsembleRunner::Scenario &scenario);
+
+  /**
+    * @brief  Writes number of Bodies, their mass and momentum, and time of
+    *         every process into CSV file. Has to be called by all
+    *         processes, only the first one writes.
+    * @param  path Path of file.
+    * @retval Was file written successfully?
+    */
+  bool Save(const QString &path);
+
+ private:
+  /**
+    * @brief Keeps share of Bodies of this process and deletes Bodies.
+    *        Every process gets the same Bodies, so they are dealt out in
+    *        turns before first balancing.
+    * @param bodies New Bodies.
+    */
+  void AddBodies(const QList<Body*> &bodies);
+
+  /**
+    * @brief Splits Hilbert curve over all Bodies into segments of equal
+    *        cost and moves Bodies to owners of their segments. Segments are
+    *        found from fixed number of samples of every process, so
+    *        balancing does not gather all Bodies.
+    */
+  void Balance();
+
+  /**
+    * @brief Sends Bodies to other processes or removes them.
+    * @param targets Rank of process which gets each Body, -1 for removed
+    *        one.
+    */
+  void Migrate(const QVector<int> &targets);
+
+  /**
+    * @brief Receives copies of Bodies of other processes near own ones and
+    *        finds all overlapping pairs with at least one own Body.
+    */
+  void FindCollisions();
+
+  /**
+    * @brief  Finds root of group of colliding Bodies.
+    * @param  body Index of Body, copies follow own Bodies.
+    * @retval Index of Body representing its group.
+    */
+  int FindGroup(int body);
+
+  /**
+    * @brief Merges groups of colliding Bodies whose lowest id is own one
+    *        and sends Bodies of other groups to owner of their lowest id.
+    */
+  void ResolveCollisions();
+
+  /**
+    * @brief Advances simulation by one time step.
+    */
+  void Step();
+
+  int rank_;
+  int process_count_;
+  WorkerPool *pool_;
+  Stepper *stepper_;
+  qreal time_step_;
+  int step_;
+  // Own Bodies.
+  QVector<quint32> ids_;
+  QVector<QPointF> positions_;
+  QVector<QPointF> velocities_;
+  QVector<qreal> masses_;
+  QVector<qreal> radii_;
+  QVector<bool> test_particles_;
+  // Masses of own Bodies which pull others, 0 for test particles.
+  QVector<qreal> source_masses_;
+  // Copies of Bodies of other processes near own ones, with their owners.
+  QVector<quint32> ghost_ids_;
+  QVector<QPointF> ghost_positions_;
+  QVector<qreal> ghost_radii_;
+  QVector<int> ghost_ranks_;
+  // Overlapping pairs, with copies indexed after own Bodies.
+  QVector<std::pair<int, int> > pairs_;
+  // Parent of each Body in union of colliding groups.
+  QVector<int> groups_;
+  // Busy time of pool_ at last balancing. Time of communication is not
+  // included, so it measures work of this process [s].
+  double balanced_seconds_;
+  // Time of whole run [s].
+  qreal seconds_;
+};
+
+#endif // DISTRIBUTED_RUNNER_H
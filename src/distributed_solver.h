@@ -0,0 +1,187 @@
+/**
+  ******************************************************************************
+  * @file    distributed_solver.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of DistributedSolver class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef DISTRIBUTED_SOLVER_H
+#define DISTRIBUTED_SOLVER_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include <algorithm>
+#include <limits>
+#include <mpi.h>
+
+#include "mpi_exchange.h"
+#include "softening_kernels.h"
+#include "tree_solver.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Force policy of one of MPI processes, each of which holds part
+  *        of Bodies. Every process builds tree of its Bodies and sends to
+  *        each other process sources which pull its bounding rectangle as
+  *        that tree would (locally essential tree). Own Bodies are then
+  *        pulled by tree of own and received sources. Every call exchanges
+  *        data, so all processes have to call it the same number of times.
+  */
+template <typename Scalar, template <typename> class Kernel = CutoffKernel>
+class DistributedSolver {
+ public:
+  // Received sources get ids from that one up, so they never match ids of
+  // Bodies.
+  static constexpr quint32 kFirstSourceId = 0x80000000u;
+
+  /**
+    * @brief DistributedSolver constructor. MPI has to be initialized.
+    * @param grav_constant Gravitational constant.
+    * @param softening_length Softening length of Kernel.
+    * @param pool Threads which sum forces.
+    */
+  DistributedSolver(qreal grav_constant, qreal softening_length,
+                    WorkerPool *pool)
+      : local_tree_(grav_constant, softening_length, pool),
+        tree_(grav_constant, softening_length, pool) {
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank_);
+    MPI_Comm_size(MPI_COMM_WORLD, &process_count_);
+  }
+
+  /**
+    * @brief  Gravitational constant accessor.
+    * @retval Gravitational constant.
+    */
+  qreal GetGravConstant() const {
+    return tree_.GetGravConstant();
+  }
+
+  /**
+    * @brief Ids mutator. Ids let both trees be kept between calls.
+    * @param ids Ids of own Bodies, indexed like positions in next calls.
+    */
+  void SetIds(const QVector<quint32> &ids) {
+    ids_ = ids;
+    local_tree_.SetIds(ids);
+  }
+
+  /**
+    * @brief Finds gravitational acceleration of every own Body, pulled by
+    *        Bodies of all processes.
+    * @param positions Positions of own Bodies.
+    * @param masses Masses of own Bodies. Bodies with mass 0 are only
+    *        pulled.
+    * @param accelerations Accelerations of own Bodies.
+    */
+  void Accelerate(const QVector<QPointF> &positions,
+                  const QVector<qreal> &masses,
+                  QVector<QPointF> *accelerations) {
+    const int count = positions.size();
+    local_tree_.Accelerate(0, positions, masses, accelerations);
+
+    // Empty rectangle of process without Bodies has left edge on the
+    // right.
+    double box[4] = {std::numeric_limits<double>::max(),
+                     std::numeric_limits<double>::max(),
+                     -std::numeric_limits<double>::max(),
+                     -std::numeric_limits<double>::max()};
+    for (int i = 0; i < count; ++i) {
+      box[0] = std::min(box[0], positions.at(i).x());
+      box[1] = std::min(box[1], positions.at(i).y());
+      box[2] = std::max(box[2], positions.at(i).x());
+      box[3] = std::max(box[3], positions.at(i).y());
+    }
+    boxes_.resize(4 * process_count_);
+    MPI_Allgather(box, 4, MPI_DOUBLE, boxes_.data(), 4, MPI_DOUBLE,
+                  MPI_COMM_WORLD);
+    outgoing_.resize(process_count_);
+    for (int r = 0; r < process_count_; ++r) {
+      outgoing_[r].clear();
+      const double *other = boxes_.constData() + 4 * r;
+      if (r == rank_ || other[0] > other[2])
+        continue;
+      export_positions_.clear();
+      export_masses_.clear();
+      local_tree_.Export(QRectF(other[0], other[1], other[2] - other[0],
+                                other[3] - other[1]),
+                         &export_positions_, &export_masses_);
+      for (int i = 0; i < export_positions_.size(); ++i) {
+        outgoing_[r].append(export_positions_.at(i).x());
+        outgoing_[r].append(export_positions_.at(i).y());
+        outgoing_[r].append(export_masses_.at(i));
+      }
+    }
+    ExchangeRecords(outgoing_, &incoming_);
+
+    // Own Bodies come first, so only they are pulled.
+    const int source_count = incoming_.size() / 3;
+    all_positions_ = positions;
+    all_masses_ = masses;
+    all_ids_.resize(count + source_count);
+    for (int i = 0; i < count; ++i)
+      all_ids_[i] = ids_.size() == count ? ids_.at(i) : i;
+    for (int i = 0; i < source_count; ++i) {
+      all_positions_.append(QPointF(incoming_.at(3 * i),
+                                    incoming_.at(3 * i + 1)));
+      all_masses_.append(incoming_.at(3 * i + 2));
+      all_ids_[count + i] = kFirstSourceId + i;
+    }
+    tree_.SetIds(all_ids_);
+    tree_.Accelerate(count, all_positions_, all_masses_, accelerations);
+  }
+
+  /**
+    * @brief Adds bytes of Bodies in both trees to NUMA nodes where they
+    *        are.
+    * @param node_bytes Bytes on each node.
+    */
+  void CountNodeBytes(QVector<qint64> *node_bytes) const {
+    local_tree_.CountNodeBytes(node_bytes);
+    tree_.CountNodeBytes(node_bytes);
+  }
+
+ private:
+  int rank_;
+  int process_count_;
+  // Tree of own Bodies, from which sources of other processes are taken.
+  TreeSolver<Scalar, Kernel> local_tree_;
+  // Tree of own Bodies and received sources.
+  TreeSolver<Scalar, Kernel> tree_;
+  QVector<quint32> ids_;
+  // Bounding rectangles of Bodies of all processes, left, top, right and
+  // bottom.
+  QVector<double> boxes_;
+  QVector<QPointF> export_positions_;
+  QVector<qreal> export_masses_;
+  // Sources for each process and received ones, as x, y and mass.
+  QVector<QVector<double> > outgoing_;
+  QVector<double> incoming_;
+  QVector<QPointF> all_positions_;
+  QVector<qreal> all_masses_;
+  QVector<quint32> all_ids_;
+};
+
+#endif // DISTRIBUTED_SOLVER_H
@@ -0,0 +1,248 @@
+/**
+  ******************************************************************************
+  * @file    dormand_prince_integrator.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of DormandPrinceIntegrator class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef DORMAND_PRINCE_INTEGRATOR_H
+#define DORMAND_PRINCE_INTEGRATOR_H
+
+#include <QPointF>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/**
+  * @brief Integration policy of adaptive Dormand-Prince 5(4) method. Time
+  *        step of simulation is covered by substeps, whose length follows
+  *        difference between embedded fifth and fourth order solutions, so
+  *        quiet phases take few long substeps and close encounters many
+  *        short ones. Last stage is evaluated at new state and reused as
+  *        first stage of next substep, so accepted substep costs six force
+  *        evaluations.
+  */
+template <class Solver>
+class DormandPrinceIntegrator {
+ public:
+  static constexpr int kStages = 7;
+  // Limits of change of substep length after one substep.
+  static constexpr qreal kMinFactor = 0.2;
+  static constexpr qreal kMaxFactor = 5.0;
+  // Substep length is chosen with margin, so fewer substeps are rejected.
+  static constexpr qreal kSafety = 0.9;
+  // Substeps shorter than that part of time step are accepted whatever
+  // their error is, so near collisions and discontinuity of forces at
+  // minimal distance do not stall simulation.
+  static constexpr qreal kMinSubstep = 1e-4;
+
+  /**
+    * @brief DormandPrinceIntegrator constructor.
+    */
+  DormandPrinceIntegrator() : tolerance_(1e-8), substep_(0.0) {}
+
+  /**
+    * @brief Tolerance mutator.
+    * @param tolerance Largest error of one substep, relative to position
+    *        and velocity of Body.
+    */
+  void SetTolerance(qreal tolerance) {
+    tolerance_ = tolerance;
+  }
+
+  /**
+    * @brief Advances Bodies by one time step, made of as many substeps as
+    *        tolerance requires.
+    * @param time_step Time step.
+    * @param solver Force policy.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void Advance(qreal time_step, Solver *solver, const QVector<qreal> &masses,
+               QVector<QPointF> *positions, QVector<QPointF> *velocities) {
+    const int count = positions->size();
+    for (int stage = 0; stage < kStages; ++stage) {
+      stage_velocities_[stage].resize(count);
+      stage_accelerations_[stage].resize(count);
+    }
+    new_positions_.resize(count);
+    new_velocities_.resize(count);
+    // Forces at end of previous step are valid only if Bodies were not
+    // changed since then.
+    if (!IsLastState(*positions, masses))
+      solver->Accelerate(*positions, masses, &stage_accelerations_[0]);
+    if (!(substep_ > 0.0))
+      substep_ = time_step;
+
+    qreal remaining = time_step;
+    while (remaining > 0.0) {
+      const qreal min_substep = kMinSubstep * time_step;
+      substep_ = std::max(substep_, min_substep);
+      const bool last = substep_ >= remaining;
+      const qreal substep = last ? remaining : substep_;
+      const qreal error = TrySubstep(substep, solver, masses, *positions,
+                                     *velocities);
+      // Exponent 1/5 follows order of embedded error estimate.
+      const qreal factor = error > 0.0 ?
+          std::min(static_cast<qreal>(kMaxFactor),
+                   std::max(static_cast<qreal>(kMinFactor),
+                            kSafety * std::pow(error, -0.2))) :
+          static_cast<qreal>(kMaxFactor);
+      if (error <= 1.0 || substep <= min_substep) {
+        positions->swap(new_positions_);
+        velocities->swap(new_velocities_);
+        stage_accelerations_[0].swap(stage_accelerations_[kStages - 1]);
+        remaining = last ? 0.0 : remaining - substep;
+        // Substep shortened to end of time step says little about the
+        // next one.
+        substep_ = last ? std::max(substep_, substep * factor)
+                        : substep * factor;
+      } else {
+        substep_ = substep * std::min(factor, 1.0);
+      }
+    }
+    last_positions_ = *positions;
+    last_masses_ = masses;
+  }
+
+ private:
+  /**
+    * @brief  Computes all stages of one substep into new_positions_ and
+    *         new_velocities_.
+    * @param  substep Length of substep.
+    * @param  solver Force policy.
+    * @param  masses Masses of Bodies.
+    * @param  positions Positions of Bodies.
+    * @param  velocities Velocities of Bodies.
+    * @retval Estimated error relative to tolerance. Substep is accepted if
+    *         it is not greater than 1.
+    */
+  qreal TrySubstep(qreal substep, Solver *solver,
+                   const QVector<qreal> &masses,
+                   const QVector<QPointF> &positions,
+                   const QVector<QPointF> &velocities) {
+    // Coefficients of stages. Last row gives fifth order solution and its
+    // stage is first stage of next substep.
+    static const qreal kCoefficients[kStages][kStages - 1] = {
+        {0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+        {3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0},
+        {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0},
+        {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0,
+         -212.0 / 729.0, 0.0, 0.0},
+        {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0,
+         -5103.0 / 18656.0, 0.0},
+        {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0,
+         -2187.0 / 6784.0, 11.0 / 84.0}};
+    // Differences between weights of fifth and fourth order solutions.
+    static const qreal kErrorWeights[kStages] = {
+        71.0 / 57600.0, 0.0, -71.0 / 16695.0, 71.0 / 1920.0,
+        -17253.0 / 339200.0, 22.0 / 525.0, -1.0 / 40.0};
+
+    const int count = positions.size();
+    const QPointF *position = positions.constData();
+    const QPointF *velocity = velocities.constData();
+    QPointF *new_position = new_positions_.data();
+    QPointF *new_velocity = new_velocities_.data();
+    stage_velocities_[0] = velocities;
+    for (int stage = 1; stage < kStages; ++stage) {
+      const qreal *coefficients = kCoefficients[stage];
+      QPointF *stage_velocity = stage_velocities_[stage].data();
+      for (int i = 0; i < count; ++i) {
+        QPointF delta_position(0.0, 0.0);
+        QPointF delta_velocity(0.0, 0.0);
+        for (int k = 0; k < stage; ++k) {
+          delta_position += stage_velocities_[k].at(i) * coefficients[k];
+          delta_velocity += stage_accelerations_[k].at(i) * coefficients[k];
+        }
+        new_position[i] = position[i] + delta_position * substep;
+        stage_velocity[i] = velocity[i] + delta_velocity * substep;
+      }
+      solver->Accelerate(new_positions_, masses,
+                         &stage_accelerations_[stage]);
+    }
+    // Last stage was evaluated at new state.
+    new_velocities_ = stage_velocities_[kStages - 1];
+
+    qreal error = 0.0;
+    for (int i = 0; i < count; ++i) {
+      QPointF position_error(0.0, 0.0);
+      QPointF velocity_error(0.0, 0.0);
+      for (int k = 0; k < kStages; ++k) {
+        position_error += stage_velocities_[k].at(i) * kErrorWeights[k];
+        velocity_error += stage_accelerations_[k].at(i) * kErrorWeights[k];
+      }
+      // The worst Body decides, so one close pair is not hidden by others.
+      error = std::max(error, Norm(position_error) * substep /
+                       (tolerance_ * (1.0 + std::max(Norm(position[i]),
+                                                     Norm(new_position[i])))));
+      error = std::max(error, Norm(velocity_error) * substep /
+                       (tolerance_ * (1.0 + std::max(Norm(velocity[i]),
+                                                     Norm(new_velocity[i])))));
+    }
+    return error;
+  }
+
+  /**
+    * @brief  Checks if Bodies are in state left by last time step.
+    * @param  positions Positions of Bodies.
+    * @param  masses Masses of Bodies.
+    * @retval Are positions and masses the same bit by bit?
+    */
+  bool IsLastState(const QVector<QPointF> &positions,
+                   const QVector<qreal> &masses) const {
+    return positions.size() == last_positions_.size() &&
+           masses.size() == last_masses_.size() &&
+           memcmp(positions.constData(), last_positions_.constData(),
+                  positions.size() * sizeof(QPointF)) == 0 &&
+           memcmp(masses.constData(), last_masses_.constData(),
+                  masses.size() * sizeof(qreal)) == 0;
+  }
+
+  /**
+    * @brief  Finds length of vector.
+    * @param  vector Vector.
+    * @retval Length of vector.
+    */
+  static qreal Norm(const QPointF &vector) {
+    return std::sqrt(vector.x() * vector.x() + vector.y() * vector.y());
+  }
+
+  qreal tolerance_;
+  // Length of next substep, kept between time steps.
+  qreal substep_;
+  // Velocities and accelerations of Bodies at every stage.
+  QVector<QPointF> stage_velocities_[kStages];
+  QVector<QPointF> stage_accelerations_[kStages];
+  // State at end of substep.
+  QVector<QPointF> new_positions_;
+  QVector<QPointF> new_velocities_;
+  // State after last time step, at which stage_accelerations_[0] was found.
+  QVector<QPointF> last_positions_;
+  QVector<qreal> last_masses_;
+};
+
+#endif // DORMAND_PRINCE_INTEGRATOR_H
@@ -0,0 +1,244 @@
+/**
+  ******************************************************************************
+  * @file    ensemble_runner.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   EnsembleRunner class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "ensemble_runner.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QStringList>
+#include <QTextStream>
+
+#include "cpu_features.h"
+#include "presets.h"
+#include "simulation.h"
+#include "worker_pool.h"
+
+/**
+  * @brief  Finds method of integration by its name.
+  * @param  name Name of method: euler, rk4, wh or dopri5.
+  * @param  method Found method.
+  * @retval Is name known?
+  */
+static bool MethodOfName(const QString &name, Simulation::Method *method) {
+  if (name == "euler")
+    *method = Simulation::kEuler;
+  else if (name == "rk4")
+    *method = Simulation::kRungeKutta;
+  else if (name == "wh")
+    *method = Simulation::kWisdomHolman;
+  else if (name == "dopri5")
+    *method = Simulation::kDormandPrince;
+  else
+    return false;
+  return true;
+}
+
+/**
+  * @brief  Finds softening of gravity by its name.
+  * @param  name Name of softening: none, plummer or spline.
+  * @param  softening Found softening.
+  * @retval Is name known?
+  */
+static bool SofteningOfName(const QString &name,
+                            Simulation::Softening *softening) {
+  if (name == "none")
+    *softening = Simulation::kCutoff;
+  else if (name == "plummer")
+    *softening = Simulation::kPlummer;
+  else if (name == "spline")
+    *softening = Simulation::kSpline;
+  else
+    return false;
+  return true;
+}
+
+EnsembleRunner::EnsembleRunner(int thread_count)
+    : thread_count_(thread_count) {
+}
+
+bool EnsembleRunner::Load(const QString &path, QString *error) {
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    *error = QString("Could not open %1.").arg(path);
+    return false;
+  }
+  scenarios_.clear();
+  QTextStream in(&file);
+  int line_number = 0;
+  while (!in.atEnd()) {
+    QString line = in.readLine();
+    ++line_number;
+    line = line.left(line.indexOf('#')).trimmed();
+    if (line.isEmpty())
+      continue;
+
+    Scenario scenario;
+    scenario.name = QString::number(scenarios_.size());
+    scenario.preset = "solar";
+    scenario.bodies = kProtodiskBodies;
+    scenario.test_particles = false;
+    scenario.perturbation = 0.0;
+    scenario.seed = 1;
+    scenario.steps = 1000;
+    scenario.time_step = 0.01;
+    scenario.tolerance = Simulation::kDefaultTolerance;
+    scenario.method = Simulation::kEuler;
+    scenario.single_precision = false;
+    scenario.solver = Simulation::kDirect;
+    scenario.softening = Simulation::kCutoff;
+    scenario.softening_length = Simulation::kDefaultSofteningLength;
+    scenario.autotune = false;
+    scenario.accuracy = AutoTuner::kDefaultAccuracy;
+    foreach (const QString &pair, line.split(' ', QString::SkipEmptyParts)) {
+      const QString key = pair.section('=', 0, 0);
+      const QString value = pair.section('=', 1);
+      bool ok = true;
+      if (key == "name")
+        scenario.name = value;
+      else if (key == "preset")
+        scenario.preset = value;
+      else if (key == "bodies")
+        scenario.bodies = value.toInt(&ok);
+      else if (key == "test-particles")
+        scenario.test_particles = value.toInt(&ok) != 0;
+      else if (key == "perturbation")
+        scenario.perturbation = value.toDouble(&ok);
+      else if (key == "seed")
+        scenario.seed = value.toUInt(&ok);
+      else if (key == "steps")
+        scenario.steps = value.toInt(&ok);
+      else if (key == "time-step")
+        scenario.time_step = value.toDouble(&ok);
+      else if (key == "tolerance")
+        scenario.tolerance = value.toDouble(&ok);
+      else if (key == "method")
+        ok = MethodOfName(value, &scenario.method);
+      else if (key == "rk4")
+        scenario.method = value.toInt(&ok) != 0 ? Simulation::kRungeKutta
+                                                : Simulation::kEuler;
+      else if (key == "single")
+        scenario.single_precision = value.toInt(&ok) != 0;
+      else if (key == "tree")
+        scenario.solver = value.toInt(&ok) != 0 ? Simulation::kTree
+                                                : Simulation::kDirect;
+      else if (key == "softening")
+        ok = SofteningOfName(value, &scenario.softening);
+      else if (key == "softening-length")
+        scenario.softening_length = value.toDouble(&ok);
+      else if (key == "autotune")
+        scenario.autotune = value.toInt(&ok) != 0;
+      else if (key == "accuracy")
+        scenario.accuracy = value.toDouble(&ok);
+      else
+        ok = false;
+      if (!ok) {
+        *error = QString("Invalid %1 in line %2.").arg(pair).arg(line_number);
+        return false;
+      }
+    }
+    if ((scenario.preset != "solar" && scenario.preset != "protodisk") ||
+        scenario.steps < 0 || scenario.time_step <= 0.0 ||
+        scenario.tolerance <= 0.0 || scenario.softening_length <= 0.0 ||
+        scenario.accuracy <= 0.0) {
+      *error = QString("Invalid scenario in line %1.").arg(line_number);
+      return false;
+    }
+    scenarios_.append(scenario);
+  }
+  return true;
+}
+
+void EnsembleRunner::Run() {
+  results_.resize(scenarios_.size());
+  Result *results = results_.data();
+  // Each scenario is a separate task, so idle threads take next scenario
+  // and long ones do not hold back the others.
+  WorkerPool pool(thread_count_);
+  pool.Run(scenarios_.size(), [&](int task, int) {
+    results[task] = RunScenario(scenarios_.at(task));
+  });
+}
+
+bool EnsembleRunner::Save(const QString &path) const {
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    return false;
+  QTextStream out(&file);
+  out.setRealNumberPrecision(12);
+  out << "name,preset,seed,steps,start_bodies,end_bodies,start_energy,"
+         "end_energy,relative_energy_error,seconds,kernels\n";
+  const QString kernels = NameOfInstructionSet(GetInstructionSet());
+  for (int i = 0; i < results_.size(); ++i) {
+    const Scenario &scenario = scenarios_.at(i);
+    const Result &result = results_.at(i);
+    const qreal error = result.start_energy != 0.0
+        ? (result.end_energy - result.start_energy) /
+          qAbs(result.start_energy)
+        : 0.0;
+    out << scenario.name << "," << scenario.preset << "," << scenario.seed
+        << "," << scenario.steps << "," << result.start_bodies << ","
+        << result.end_bodies << "," << result.start_energy << ","
+        << result.end_energy << "," << error << "," << result.seconds
+        << "," << kernels << "\n";
+  }
+  out.flush();
+  return file.error() == QFile::NoError;
+}
+
+EnsembleRunner::Result EnsembleRunner::RunScenario(const Scenario &scenario) {
+  // Scenarios already run in parallel, so each one uses single thread.
+  Simulation simulation(0, 1);
+  simulation.SetTimeStep(scenario.time_step);
+  simulation.SetMethod(scenario.method);
+  simulation.SetTolerance(scenario.tolerance);
+  if (scenario.single_precision)
+    simulation.SetPrecision(Simulation::kSinglePrecision);
+  simulation.SetSolver(scenario.solver);
+  simulation.SetSoftening(scenario.softening);
+  simulation.SetSofteningLength(scenario.softening_length);
+  simulation.SetTuningAccuracy(scenario.accuracy);
+  simulation.SetAutoTune(scenario.autotune);
+  // Random numbers of Qt are separate in every thread.
+  qsrand(scenario.seed);
+  if (scenario.preset == "solar")
+    simulation.AddBodies(CreateSolarSystem(scenario.perturbation));
+  else
+    simulation.AddBodies(CreateProtodisk(scenario.bodies,
+                                         scenario.test_particles));
+
+  Result result;
+  result.start_bodies = simulation.GetBodyCount();
+  result.start_energy = simulation.GetEnergy();
+  QElapsedTimer timer;
+  timer.start();
+  simulation.Run(scenario.steps);
+  result.seconds = timer.nsecsElapsed() * 1e-9;
+  result.end_bodies = simulation.GetBodyCount();
+  result.end_energy = simulation.GetEnergy();
+  return result;
+}
@@ -0,0 +1,128 @@
+/**
+  ******************************************************************************
+  * @file    ensemble_runner.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of EnsembleRunner class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef ENSEMBLE_RUNNER_H
+#define ENSEMBLE_RUNNER_H
+
+#include <QString>
+#include <QVector>
+
+#include "simulation.h"
+
+/**
+  * @brief Runs many small independent simulations at once, one per thread,
+  *        and collects their summaries into one file. Suitable for parameter
+  *        studies, where single system is too small to use many cores.
+  */
+class EnsembleRunner {
+ public:
+  // Parameters of one simulation.
+  struct Scenario {
+    QString name;
+    // Preset: solar or protodisk.
+    QString preset;
+    // Number of objects in protodisk.
+    int bodies;
+    // Are objects in protodisk test particles?
+    bool test_particles;
+    // Largest relative change of orbits of planets in solar preset.
+    qreal perturbation;
+    // Seed of random numbers used by preset.
+    uint seed;
+    int steps;
+    qreal time_step;
+    Simulation::Method method;
+    // Tolerance of adaptive method.
+    qreal tolerance;
+    bool single_precision;
+    Simulation::Solver solver;
+    Simulation::Softening softening;
+    qreal softening_length;
+    // Are solver and precision chosen automatically?
+    bool autotune;
+    // Largest relative error of forces accepted by automatic tuning.
+    qreal accuracy;
+  };
+
+  // Summary of one simulation.
+  struct Result {
+    int start_bodies;
+    int end_bodies;
+    qreal start_energy;
+    qreal end_energy;
+    // Wall clock time of simulation [s].
+    qreal seconds;
+  };
+
+  /**
+    * @brief EnsembleRunner constructor.
+    * @param thread_count Number of simulations run at once. Value 0 means
+    *        number of processor cores.
+    */
+  explicit EnsembleRunner(int thread_count = 0);
+
+  /**
+    * @brief  Reads scenarios from text file. Each line describes one
+    *         scenario as key=value pairs separated by spaces, e.g.
+    *         "name=a preset=solar perturbation=0.01 seed=1 steps=1000
+    *         method=wh".
+    *         Missing keys have default values. Text after # is ignored.
+    * @param  path Path of file.
+    * @param  error Description of error, if any.
+    * @retval Were scenarios read successfully?
+    */
+  bool Load(const QString &path, QString *error);
+
+  /**
+    * @brief Runs all scenarios. Blocks until all of them are finished.
+    */
+  void Run();
+
+  /**
+    * @brief  Writes results of all scenarios into CSV file, in order of
+    *         scenarios.
+    * @param  path Path of file.
+    * @retval Was file written successfully?
+    */
+  bool Save(const QString &path) const;
+
+ private:
+  /**
+    * @brief  Runs one scenario in calling thread.
+    * @param  scenario Parameters of simulation.
+    * @retval Summary of simulation.
+    */
+  static Result RunScenario(const Scenario &scenario);
+
+  int thread_count_;
+  QVector<Scenario> scenarios_;
+  // Results in order of scenarios_.
+  QVector<Result> results_;
+};
+
+#endif // ENSEMBLE_RUNNER_H
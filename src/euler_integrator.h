@@ -0,0 +1,75 @@
+/**
+  ******************************************************************************
+  * @file    euler_integrator.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of EulerIntegrator class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef EULER_INTEGRATOR_H
+#define EULER_INTEGRATOR_H
+
+#include <QPointF>
+#include <QVector>
+
+/**
+  * @brief Integration policy of semi-implicit Euler method. Velocity is
+  *        updated first and new one moves Body.
+  */
+template <class Solver>
+class EulerIntegrator {
+ public:
+  /**
+    * @brief Tolerance mutator. Time step is fixed, so tolerance is not used.
+    * @param tolerance Largest error of one step.
+    */
+  void SetTolerance(qreal tolerance) {
+    Q_UNUSED(tolerance);
+  }
+
+  /**
+    * @brief Advances Bodies by one time step.
+    * @param time_step Time step.
+    * @param solver Force policy.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void Advance(qreal time_step, Solver *solver, const QVector<qreal> &masses,
+               QVector<QPointF> *positions, QVector<QPointF> *velocities) {
+    solver->Accelerate(*positions, masses, &accelerations_);
+    const int count = positions->size();
+    const QPointF *acceleration = accelerations_.constData();
+    QPointF *position = positions->data();
+    QPointF *velocity = velocities->data();
+    for (int i = 0; i < count; ++i) {
+      velocity[i] += acceleration[i] * time_step;
+      position[i] += velocity[i] * time_step;
+    }
+  }
+
+ private:
+  QVector<QPointF> accelerations_;
+};
+
+#endif // EULER_INTEGRATOR_H
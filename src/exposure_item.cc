@@ -0,0 +1,132 @@
+/**
+  ******************************************************************************
+  * @file    exposure_item.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   ExposureItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "exposure_item.h"
+
+#include <QPainter>
+#include <QtMath>
+
+#include "body.h"
+
+ExposureItem::ExposureItem()
+    : QGraphicsItem() {
+  setZValue(-1);
+}
+
+void ExposureItem::Expose(const Frame &frame) {
+  if (image_.isNull())
+    return;
+  Fade();
+
+  const qreal scale = transform_.m11();
+  const int width = image_.width();
+  const int height = image_.height();
+  const int stride = image_.bytesPerLine() / sizeof(QRgb);
+  QRgb *pixels = reinterpret_cast<QRgb*>(image_.bits());
+  QPainter painter;
+  for (int i = 0; i < frame.positions.size(); ++i) {
+    const QPointF position = transform_.map(frame.positions.at(i));
+    const qreal radius = frame.radii.at(i) * scale;
+    if (radius <= 1.0) {
+      // Most Bodies are not bigger than pixel, so they are written directly.
+      const int x = qFloor(position.x());
+      const int y = qFloor(position.y());
+      if (x >= 0 && x < width && y >= 0 && y < height)
+        pixels[y * stride + x] = Body::ColorOfMass(frame.masses.at(i)).rgb();
+    } else {
+      if (!painter.isActive()) {
+        painter.begin(&image_);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setPen(Qt::NoPen);
+      }
+      painter.setBrush(Body::ColorOfMass(frame.masses.at(i)));
+      painter.drawEllipse(position, radius, radius);
+    }
+  }
+  if (painter.isActive())
+    painter.end();
+  update();
+}
+
+void ExposureItem::Clear() {
+  image_.fill(Qt::transparent);
+  update();
+}
+
+void ExposureItem::SetViewTransform(const QTransform &transform,
+                                    const QSize &size) {
+  if (image_.size() != size || transform.m11() != transform_.m11() ||
+      transform.m22() != transform_.m22()) {
+    // Exposed positions are no longer valid after zooming.
+    image_ = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    image_.fill(Qt::transparent);
+  } else if (transform.dx() != transform_.dx() ||
+             transform.dy() != transform_.dy()) {
+    // After panning exposed positions are only moved.
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.drawImage(QPointF(transform.dx() - transform_.dx(),
+                              transform.dy() - transform_.dy()), image_);
+    painter.end();
+    image_ = image;
+  }
+  transform_ = transform;
+
+  prepareGeometryChange();
+  bounding_rect_ = transform_.inverted().mapRect(QRectF(QPointF(0, 0), size));
+  update();
+}
+
+QRectF ExposureItem::boundingRect() const {
+  return bounding_rect_;
+}
+
+void ExposureItem::paint(QPainter *painter,
+                         const QStyleOptionGraphicsItem *option,
+                         QWidget *widget) {
+  Q_UNUSED(option);
+  Q_UNUSED(widget);
+  if (image_.isNull())
+    return;
+  painter->save();
+  painter->resetTransform();
+  painter->drawImage(0, 0, image_);
+  painter->restore();
+}
+
+void ExposureItem::Fade() {
+  // Rounding down makes sure that every pixel becomes fully dark eventually.
+  // Scaling all components keeps premultiplied colours valid.
+  uchar *bits = image_.bits();
+  const int count = image_.bytesPerLine() * image_.height();
+  for (int i = 0; i < count; ++i)
+    bits[i] = (bits[i] * kFade) >> 8;
+}
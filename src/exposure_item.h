@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    exposure_item.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of ExposureItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef EXPOSURE_ITEM_H
+#define EXPOSURE_ITEM_H
+
+#include <QGraphicsItem>
+#include <QImage>
+#include <QTransform>
+
+#include "frame.h"
+
+/**
+  * @brief Graphics item which shows positions of Bodies from many frames, like
+  *        photograph with long exposure time. Positions are drawn into image
+  *        in coordinates of View, which fades a little in every frame.
+  */
+class ExposureItem : public QGraphicsItem {
+ public:
+  // Brightness left after one frame, in 1/256 units.
+  static constexpr int kFade = 252;
+
+  /**
+    * @brief ExposureItem constructor.
+    */
+  ExposureItem();
+
+  /**
+    * @brief Fades image and draws current positions of Bodies into it.
+    * @param frame State of Bodies.
+    */
+  void Expose(const Frame &frame);
+
+  /**
+    * @brief Makes image fully dark.
+    */
+  void Clear();
+
+  /**
+    * @brief Tells item how Scene is mapped into View. Image is moved when
+    *        View was panned and cleared when it was zoomed or resized.
+    * @param transform Transformation from Scene to viewport coordinates.
+    * @param size Size of viewport.
+    */
+  void SetViewTransform(const QTransform &transform, const QSize &size);
+
+  /**
+    * @brief  Bounding rectangle accessor.
+    * @retval Rectangle of Scene visible in View.
+    */
+  QRectF boundingRect() const;
+
+  /**
+    * @brief Draws image in viewport coordinates.
+    * @param painter Painter.
+    * @param option Style options.
+    * @param widget Widget being painted on.
+    */
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+             QWidget *widget);
+
+ private:
+  /**
+    * @brief Multiplies brightness of every pixel of image by kFade / 256.
+    */
+  void Fade();
+
+  // Accumulated image in viewport coordinates.
+  QImage image_;
+  QTransform transform_;
+  QRectF bounding_rect_;
+};
+
+#endif // EXPOSURE_ITEM_H
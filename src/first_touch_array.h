@@ -0,0 +1,155 @@
+/**
+  ******************************************************************************
+  * @file    first_touch_array.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of FirstTouchArray class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef FIRST_TOUCH_ARRAY_H
+#define FIRST_TOUCH_ARRAY_H
+
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+#include "numa_placement.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Array of plain values, which is first written by workers of
+  *        WorkerPool in blocks. Memory pages go to NUMA node of thread
+  *        which first touches them, and QVector fills new memory in calling
+  *        thread. Here each block lands on node of worker which later
+  *        works on it, when pool is pinned and blocks are the same.
+  */
+template <typename T>
+class FirstTouchArray {
+ public:
+  /**
+    * @brief FirstTouchArray constructor.
+    */
+  FirstTouchArray()
+      : data_(NULL),
+        size_(0),
+        capacity_(0) {
+  }
+
+  /**
+    * @brief FirstTouchArray destructor.
+    */
+  ~FirstTouchArray() {
+    std::free(data_);
+  }
+
+  /**
+    * @brief Changes size of array. Memory is allocated anew only when array
+    *        grows, then values are zero and each block is written first by
+    *        worker of its task. Otherwise values are kept.
+    * @param size New number of values.
+    * @param block_size Number of values written in one task.
+    * @param pool Threads which write blocks.
+    */
+  void Resize(int size, int block_size, WorkerPool *pool) {
+    if (size > capacity_) {
+      // Large blocks come straight from the system untouched, so placement
+      // is decided below.
+      T *data = static_cast<T*>(std::malloc(sizeof(T) * size));
+      if (data == NULL)
+        throw std::bad_alloc();
+      const int block_count = (size + block_size - 1) / block_size;
+      pool->Run(block_count, [&](int block, int) {
+        const int end = std::min((block + 1) * block_size, size);
+        for (int i = block * block_size; i < end; ++i)
+          data[i] = T();
+      });
+      std::free(data_);
+      data_ = data;
+      capacity_ = size;
+    }
+    size_ = size;
+  }
+
+  /**
+    * @brief  Size accessor.
+    * @retval Number of values.
+    */
+  int size() const {
+    return size_;
+  }
+
+  /**
+    * @brief  Values accessor.
+    * @retval First value.
+    */
+  T *data() {
+    return data_;
+  }
+
+  /**
+    * @brief  Values accessor.
+    * @retval First value.
+    */
+  const T *constData() const {
+    return data_;
+  }
+
+  /**
+    * @brief  Value accessor.
+    * @param  i Index of value.
+    * @retval Value.
+    */
+  T &operator[](int i) {
+    return data_[i];
+  }
+
+  /**
+    * @brief  Value accessor.
+    * @param  i Index of value.
+    * @retval Value.
+    */
+  const T &at(int i) const {
+    return data_[i];
+  }
+
+  /**
+    * @brief Adds bytes of allocated memory to NUMA nodes where it is.
+    * @param node_bytes Bytes on each node.
+    */
+  void CountNodeBytes(QVector<qint64> *node_bytes) const {
+    ::CountNodeBytes(data_, sizeof(T) * static_cast<qint64>(capacity_),
+                     node_bytes);
+  }
+
+ private:
+  Q_DISABLE_COPY(FirstTouchArray)
+
+  T *data_;
+  int size_;
+  // Number of allocated values.
+  int capacity_;
+};
+
+#endif // FIRST_TOUCH_ARRAY_H
@@ -0,0 +1,68 @@
+/**
+  ******************************************************************************
+  * @file    frame.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of Frame structure.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+  * @brief State of all Bodies published by Simulation for drawing. Vectors
+  *        are implicitly shared, so copying Frame is cheap.
+  */
+struct Frame {
+  QVector<QPointF> positions;
+  QVector<qreal> radii;
+  QVector<qreal> masses;
+  // Identifiers of Bodies. Simulation reorders Bodies from time to time, so
+  // index of Body can differ between Frames.
+  QVector<quint32> ids;
+  // Hash of state of all Bodies, 0 if Simulation is not deterministic.
+  quint64 state_hash;
+  // Points of all trails, from the oldest to the newest one of each Body.
+  QVector<QPointF> trail_points;
+  // Index of first point of each trail. Last element is number of points.
+  // Empty if trails are not recorded.
+  QVector<int> trail_offsets;
+  // Memory used by Bodies and their trails [B].
+  qint64 memory_bytes = 0;
+  // Memory reserved by pools of Bodies and trails of all Simulations [B].
+  qint64 reserved_bytes = 0;
+  // Bytes of force arrays on each NUMA node, sampled every few steps [B].
+  // Empty on machines with one node.
+  QVector<qint64> node_bytes;
+  // Way of summing forces used in last step, which can be chosen by tuner.
+  bool tree = false;
+  bool single_precision = false;
+  int thread_count = 0;
+};
+
+#endif // FRAME_H
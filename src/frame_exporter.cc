@@ -0,0 +1,126 @@
+/**
+  ******************************************************************************
+  * @file    frame_exporter.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   FrameExporter class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "frame_exporter.h"
+
+#include <QDir>
+#include <QFile>
+#include <QPainter>
+#include <QTextStream>
+#include <QThread>
+
+FrameExporter::FrameExporter(Scene *scene, const QString &directory,
+                             const QSize &size, qreal view_scale,
+                             int encoder_count)
+    : scene_(scene),
+      directory_(directory),
+      size_(size),
+      view_scale_(view_scale),
+      encoder_count_(encoder_count > 0 ? encoder_count
+                                       : QThread::idealThreadCount()),
+      frames_(kFrameQueueLength),
+      images_(encoder_count_ * kImagesPerEncoder),
+      failed_(0) {
+}
+
+FrameExporter::~FrameExporter() {
+  frames_.Close();
+  images_.Close();
+  for (std::thread &encoder : encoders_)
+    encoder.join();
+}
+
+bool FrameExporter::Run(int frame_count, int cadence) {
+  if (!QDir().mkpath(directory_))
+    return false;
+
+  // Center of Scene is placed in the middle of images.
+  QTransform transform;
+  transform.translate(size_.width() / 2.0, size_.height() / 2.0);
+  transform.scale(view_scale_, view_scale_);
+  scene_->SetViewScale(view_scale_);
+  scene_->SetViewTransform(transform, size_);
+
+  for (int i = 0; i < encoder_count_; ++i)
+    encoders_.push_back(std::thread(&FrameExporter::Encode, this));
+
+  // Simulation stops advancing on timer and produces Frames in its thread
+  // as fast as they are drawn.
+  Simulation *simulation = scene_->simulation_;
+  simulation->SetPaused(true);
+  simulation->SetExportQueue(&frames_);
+  QMetaObject::invokeMethod(simulation, "Export", Qt::QueuedConnection,
+                            Q_ARG(int, frame_count), Q_ARG(int, cadence));
+
+  QFile hash_file(QDir(directory_).filePath(kHashFileName));
+  QTextStream hashes(&hash_file);
+  for (int i = 0; i < frame_count; ++i) {
+    Frame frame;
+    if (!frames_.Pop(&frame))
+      break;
+    if (frame.state_hash != 0) {
+      if (!hash_file.isOpen() &&
+          !hash_file.open(QIODevice::WriteOnly | QIODevice::Text))
+        ++failed_;
+      hashes << i << " " << QString::number(frame.state_hash, 16) << "\n";
+    }
+    scene_->ShowFrame(frame);
+    Image image = {i, Draw()};
+    images_.Push(image);
+  }
+
+  images_.Close();
+  for (std::thread &encoder : encoders_)
+    encoder.join();
+  encoders_.clear();
+  simulation->SetExportQueue(NULL);
+  return failed_ == 0;
+}
+
+void FrameExporter::Encode() {
+  Image image;
+  while (images_.Pop(&image)) {
+    QString name = QString("frame_%1.png").arg(image.index, 6, 10,
+                                                QChar('0'));
+    if (!image.image.save(QDir(directory_).filePath(name), "PNG"))
+      ++failed_;
+  }
+}
+
+QImage FrameExporter::Draw() {
+  QImage image(size_, QImage::Format_RGB32);
+  QPainter painter(&image);
+  painter.setRenderHint(QPainter::Antialiasing);
+  QRectF target(QPointF(0, 0), size_);
+  QRectF source(-size_.width() / (2.0 * view_scale_),
+                -size_.height() / (2.0 * view_scale_),
+                size_.width() / view_scale_, size_.height() / view_scale_);
+  scene_->render(&painter, target, source);
+  return image;
+}
@@ -0,0 +1,117 @@
+/**
+  ******************************************************************************
+  * @file    frame_exporter.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of FrameExporter class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef FRAME_EXPORTER_H
+#define FRAME_EXPORTER_H
+
+#include <QImage>
+#include <QString>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.h"
+#include "frame.h"
+#include "scene.h"
+
+/**
+  * @brief Renders Frames of Simulation into off-screen images and saves them
+  *        as numbered PNG files. Simulation, drawing and encoding run in
+  *        separate threads connected by bounded queues.
+  */
+class FrameExporter {
+ public:
+  // Number of Frames waiting for drawing.
+  static constexpr int kFrameQueueLength = 4;
+  // Number of drawn images waiting for encoding per encoding thread.
+  static constexpr int kImagesPerEncoder = 2;
+  // File with hashes of state of exported Frames, if Simulation is
+  // deterministic.
+  static constexpr const char *kHashFileName = "state_hashes.txt";
+
+  /**
+    * @brief FrameExporter constructor.
+    * @param scene Scene whose Simulation is exported. It is drawn with the
+    *        same items as in View.
+    * @param directory Directory to which files are written.
+    * @param size Size of images [px].
+    * @param view_scale Zoom of images. Center of Scene is in the middle.
+    * @param encoder_count Number of threads encoding PNG files. Value 0
+    *        means number of processor cores.
+    */
+  FrameExporter(Scene *scene, const QString &directory, const QSize &size,
+                qreal view_scale, int encoder_count = 0);
+
+  /**
+    * @brief FrameExporter destructor. Waits for encoding threads.
+    */
+  ~FrameExporter();
+
+  /**
+    * @brief  Advances simulation and exports its Frames. Blocks until all
+    *         files are written. Hashes of state are written into
+    *         kHashFileName if Simulation is deterministic.
+    * @param  frame_count Number of exported Frames.
+    * @param  cadence Number of steps between exported Frames.
+    * @retval Were all files written successfully?
+    */
+  bool Run(int frame_count, int cadence);
+
+ private:
+  // Drawn image with its number.
+  struct Image {
+    int index;
+    QImage image;
+  };
+
+  /**
+    * @brief Encodes queued images until queue is closed. Runs in encoding
+    *        thread.
+    */
+  void Encode();
+
+  /**
+    * @brief  Draws Scene into new image.
+    * @retval Drawn image.
+    */
+  QImage Draw();
+
+  Scene *scene_;
+  QString directory_;
+  QSize size_;
+  qreal view_scale_;
+  int encoder_count_;
+  BoundedQueue<Frame> frames_;
+  BoundedQueue<Image> images_;
+  std::vector<std::thread> encoders_;
+  // Number of files which could not be written.
+  std::atomic<int> failed_;
+};
+
+#endif // FRAME_EXPORTER_H
@@ -0,0 +1,245 @@
+/**
+  ******************************************************************************
+  * @file    gravity_kernel.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of gravity kernel.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef GRAVITY_KERNEL_H
+#define GRAVITY_KERNEL_H
+
+#include <QPointF>
+#include <QVector>
+#include <type_traits>
+
+#include "cpu_features.h"
+#include "first_touch_array.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Positions and masses of Bodies in contiguous arrays of Scalar.
+  *        Positions are relative to center of mass, so single precision
+  *        stays usable far from origin of Scene. Only Bodies with mass pull
+  *        others, so massless ones are left out of sources. Arrays are
+  *        first touched in blocks by threads which sum forces, so in pinned
+  *        pool pulled Bodies are on NUMA node of their worker and sources
+  *        are spread over all nodes.
+  */
+template <typename Scalar>
+struct BodyArrays {
+  // Number of independent sums per Body, 256 bits of them. Array lengths are
+  // multiple of it, so inner loop can be vectorized without remainder.
+  static constexpr int kLanes = 32 / sizeof(Scalar);
+
+  /**
+    * @brief Copies positions of all Bodies and positions and masses of
+    *        Bodies with mass, padding sources with massless entries.
+    * @param positions Positions of Bodies.
+    * @param masses Gravitational masses of Bodies. Test particles have 0.
+    * @param block_size Number of Bodies pulled in one task.
+    * @param pool Threads which sum forces.
+    */
+  void Gather(const QVector<QPointF> &positions,
+              const QVector<qreal> &masses, int block_size,
+              WorkerPool *pool) {
+    count = positions.size();
+    int source_count = 0;
+    qreal total_mass = 0.0;
+    QPointF center(0.0, 0.0);
+    for (int i = 0; i < count; ++i) {
+      if (masses.at(i) > 0.0)
+        ++source_count;
+      total_mass += masses.at(i);
+      center += positions.at(i) * masses.at(i);
+    }
+    origin = total_mass > 0.0 ? center / total_mass : QPointF(0.0, 0.0);
+    const int padded = (source_count + kLanes - 1) / kLanes * kLanes;
+    target_x.Resize(count, block_size, pool);
+    target_y.Resize(count, block_size, pool);
+    x.Resize(padded, block_size, pool);
+    y.Resize(padded, block_size, pool);
+    mass.Resize(padded, block_size, pool);
+    int source = 0;
+    for (int i = 0; i < count; ++i) {
+      target_x[i] = static_cast<Scalar>(positions.at(i).x() - origin.x());
+      target_y[i] = static_cast<Scalar>(positions.at(i).y() - origin.y());
+      if (masses.at(i) > 0.0) {
+        x[source] = target_x.at(i);
+        y[source] = target_y.at(i);
+        mass[source] = static_cast<Scalar>(masses.at(i));
+        ++source;
+      }
+    }
+    for (int i = source_count; i < padded; ++i) {
+      x[i] = 0;
+      y[i] = 0;
+      mass[i] = 0;
+    }
+  }
+
+  /**
+    * @brief Adds bytes of arrays to NUMA nodes where they are.
+    * @param node_bytes Bytes on each node.
+    */
+  void CountNodeBytes(QVector<qint64> *node_bytes) const {
+    target_x.CountNodeBytes(node_bytes);
+    target_y.CountNodeBytes(node_bytes);
+    x.CountNodeBytes(node_bytes);
+    y.CountNodeBytes(node_bytes);
+    mass.CountNodeBytes(node_bytes);
+  }
+
+  // Number of all Bodies.
+  int count;
+  // Center of mass, subtracted from positions.
+  QPointF origin;
+  // Positions of all Bodies, which are pulled.
+  FirstTouchArray<Scalar> target_x;
+  FirstTouchArray<Scalar> target_y;
+  // Positions and masses of Bodies which pull others.
+  FirstTouchArray<Scalar> x;
+  FirstTouchArray<Scalar> y;
+  FirstTouchArray<Scalar> mass;
+};
+
+/**
+  * @brief Sums gravitational pull of all Bodies with mass on each Body.
+  *        Single precision uses compensated (Kahan) summation in every lane
+  *        and lanes are added in double precision. Every sum is made by
+  *        one call in fixed order, so result does not depend on how Bodies
+  *        are split between calls.
+  * @param bodies Positions and masses of Bodies.
+  * @param kernel Softening kernel, which shapes gravity at short distances.
+  * @param begin Index of first pulled Body.
+  * @param end Index after last pulled Body.
+  * @param accelerations Sums of mass / distance^2 in direction of other
+  *        Bodies, before multiplying by gravitational constant. Indexed
+  *        like Bodies.
+  */
+template <typename Scalar, class Kernel>
+ALWAYS_INLINE void SumAccelerations(const BodyArrays<Scalar> &bodies,
+                                    const Kernel &kernel, int begin, int end,
+                                    QPointF *accelerations) {
+  const int kLanes = BodyArrays<Scalar>::kLanes;
+  // Double sums are precise enough without compensation.
+  const bool compensated = std::is_same<Scalar, float>::value;
+  const int padded = bodies.x.size();
+  const Scalar *target_x = bodies.target_x.constData();
+  const Scalar *target_y = bodies.target_y.constData();
+  const Scalar *x = bodies.x.constData();
+  const Scalar *y = bodies.y.constData();
+  const Scalar *mass = bodies.mass.constData();
+
+  for (int i = begin; i < end; ++i) {
+    const Scalar x_i = target_x[i];
+    const Scalar y_i = target_y[i];
+    Scalar sum_x[kLanes] = {};
+    Scalar sum_y[kLanes] = {};
+    Scalar error_x[kLanes] = {};
+    Scalar error_y[kLanes] = {};
+    for (int j = 0; j < padded; j += kLanes) {
+      for (int lane = 0; lane < kLanes; ++lane) {
+        const Scalar delta_x = x[j + lane] - x_i;
+        const Scalar delta_y = y[j + lane] - y_i;
+        const Scalar distance_squared = delta_x * delta_x + delta_y * delta_y;
+        // Kernel is inlined and branch-free, so the loop stays vectorized.
+        // Body itself adds nothing, as its distance vector is zero.
+        const Scalar factor = mass[j + lane] *
+                              kernel.Factor(distance_squared);
+        const Scalar term_x = factor * delta_x - error_x[lane];
+        const Scalar term_y = factor * delta_y - error_y[lane];
+        const Scalar new_x = sum_x[lane] + term_x;
+        const Scalar new_y = sum_y[lane] + term_y;
+        if (compensated) {
+          error_x[lane] = (new_x - sum_x[lane]) - term_x;
+          error_y[lane] = (new_y - sum_y[lane]) - term_y;
+        }
+        sum_x[lane] = new_x;
+        sum_y[lane] = new_y;
+      }
+    }
+    qreal total_x = 0.0;
+    qreal total_y = 0.0;
+    for (int lane = 0; lane < kLanes; ++lane) {
+      total_x += static_cast<qreal>(sum_x[lane]) - error_x[lane];
+      total_y += static_cast<qreal>(sum_y[lane]) - error_y[lane];
+    }
+    accelerations[i] = QPointF(total_x, total_y);
+  }
+}
+
+// Function summing accelerations like SumAccelerations.
+template <typename Scalar, class Kernel>
+using SumFunction = void (*)(const BodyArrays<Scalar> &, const Kernel &, int,
+                             int, QPointF *);
+
+/**
+  * @brief Variants of SumAccelerations, each compiled for one instruction
+  *        set.
+  */
+template <typename Scalar, class Kernel>
+void SumAccelerationsBaseline(const BodyArrays<Scalar> &bodies,
+                              const Kernel &kernel, int begin, int end,
+                              QPointF *accelerations) {
+  SumAccelerations(bodies, kernel, begin, end, accelerations);
+}
+
+#ifdef HAVE_ISA_DISPATCH
+template <typename Scalar, class Kernel>
+TARGET_AVX2 void SumAccelerationsAvx2(const BodyArrays<Scalar> &bodies,
+                                      const Kernel &kernel, int begin,
+                                      int end, QPointF *accelerations) {
+  SumAccelerations(bodies, kernel, begin, end, accelerations);
+}
+
+template <typename Scalar, class Kernel>
+TARGET_AVX512 void SumAccelerationsAvx512(const BodyArrays<Scalar> &bodies,
+                                          const Kernel &kernel, int begin,
+                                          int end, QPointF *accelerations) {
+  SumAccelerations(bodies, kernel, begin, end, accelerations);
+}
+#endif
+
+/**
+  * @brief  Chooses variant of SumAccelerations for current instruction
+  *         set.
+  * @retval Variant of SumAccelerations.
+  */
+template <typename Scalar, class Kernel>
+SumFunction<Scalar, Kernel> SelectSumAccelerations() {
+#ifdef HAVE_ISA_DISPATCH
+  switch (GetInstructionSet()) {
+    case kAvx512:
+      return &SumAccelerationsAvx512<Scalar, Kernel>;
+    case kAvx2:
+      return &SumAccelerationsAvx2<Scalar, Kernel>;
+    default:
+      break;
+  }
+#endif
+  return &SumAccelerationsBaseline<Scalar, Kernel>;
+}
+
+#endif // GRAVITY_KERNEL_H
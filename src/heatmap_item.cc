@@ -0,0 +1,261 @@
+/**
+  ******************************************************************************
+  * @file    heatmap_item.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   HeatmapItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "heatmap_item.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QPainter>
+
+#include "cpu_features.h"
+
+/**
+  * @brief Finds pixel of every Body. Pixels are found first and summed in
+  *        separate loop, so this one is vectorized.
+  * @param positions Positions of Bodies.
+  * @param count Number of Bodies.
+  * @param transform Transformation from Scene to viewport coordinates.
+  * @param width Width of image.
+  * @param height Height of image.
+  * @param pixels Index of pixel of each Body, -1 outside image.
+  */
+static ALWAYS_INLINE void FindPixels(const QPointF *positions, int count,
+                                     const QTransform &transform, int width,
+                                     int height, int *pixels) {
+  const qreal scale_x = transform.m11();
+  const qreal scale_y = transform.m22();
+  const qreal dx = transform.dx();
+  const qreal dy = transform.dy();
+  for (int i = 0; i < count; ++i) {
+    const qreal x = std::floor(positions[i].x() * scale_x + dx);
+    const qreal y = std::floor(positions[i].y() * scale_y + dy);
+    const bool inside = x >= 0.0 && x < width && y >= 0.0 && y < height;
+    pixels[i] = inside ? static_cast<int>(y) * width + static_cast<int>(x)
+                       : -1;
+  }
+}
+
+/**
+  * @brief  Adds histograms to the first one in range of pixels.
+  * @param  histograms Histograms.
+  * @param  histogram_count Number of histograms.
+  * @param  begin Index of first pixel.
+  * @param  end Index after last pixel.
+  * @retval Maximum of summed histogram in range.
+  */
+static ALWAYS_INLINE float SumHistograms(float *const *histograms,
+                                         int histogram_count, int begin,
+                                         int end) {
+  float *sum = histograms[0];
+  // Histograms are added one by one, so every pixel sums them in the same
+  // order and the loop over pixels is vectorized.
+  for (int j = 1; j < histogram_count; ++j) {
+    const float *histogram = histograms[j];
+    for (int i = begin; i < end; ++i)
+      sum[i] += histogram[i];
+  }
+  float maximum = 0.0f;
+  for (int i = begin; i < end; ++i)
+    maximum = std::max(maximum, sum[i]);
+  return maximum;
+}
+
+/**
+  * @brief Variants of FindPixels and SumHistograms, each compiled for one
+  *        instruction set.
+  */
+static void FindPixelsBaseline(const QPointF *positions, int count,
+                               const QTransform &transform, int width,
+                               int height, int *pixels) {
+  FindPixels(positions, count, transform, width, height, pixels);
+}
+
+static float SumHistogramsBaseline(float *const *histograms,
+                                   int histogram_count, int begin, int end) {
+  return SumHistograms(histograms, histogram_count, begin, end);
+}
+
+#ifdef HAVE_ISA_DISPATCH
+static TARGET_AVX2 void FindPixelsAvx2(const QPointF *positions, int count,
+                                       const QTransform &transform,
+                                       int width, int height, int *pixels) {
+  FindPixels(positions, count, transform, width, height, pixels);
+}
+
+static TARGET_AVX2 float SumHistogramsAvx2(float *const *histograms,
+                                           int histogram_count, int begin,
+                                           int end) {
+  return SumHistograms(histograms, histogram_count, begin, end);
+}
+
+static TARGET_AVX512 void FindPixelsAvx512(const QPointF *positions,
+                                           int count,
+                                           const QTransform &transform,
+                                           int width, int height,
+                                           int *pixels) {
+  FindPixels(positions, count, transform, width, height, pixels);
+}
+
+static TARGET_AVX512 float SumHistogramsAvx512(float *const *histograms,
+                                               int histogram_count,
+                                               int begin, int end) {
+  return SumHistograms(histograms, histogram_count, begin, end);
+}
+#endif
+
+HeatmapItem::HeatmapItem()
+    : QGraphicsItem(),
+      find_pixels_(&FindPixelsBaseline),
+      sum_histograms_(&SumHistogramsBaseline),
+      palette_(256),
+      mass_weighted_(false) {
+  setZValue(1);
+#ifdef HAVE_ISA_DISPATCH
+  if (GetInstructionSet() == kAvx512) {
+    find_pixels_ = &FindPixelsAvx512;
+    sum_histograms_ = &SumHistogramsAvx512;
+  } else if (GetInstructionSet() == kAvx2) {
+    find_pixels_ = &FindPixelsAvx2;
+    sum_histograms_ = &SumHistogramsAvx2;
+  }
+#endif
+  // Black, red, yellow and white, like glowing metal.
+  for (int i = 0; i < palette_.size(); ++i) {
+    qreal value = 3.0 * i / (palette_.size() - 1);
+    palette_[i] = qRgb(255 * qBound(0.0, value, 1.0),
+                       255 * qBound(0.0, value - 1.0, 1.0),
+                       255 * qBound(0.0, value - 2.0, 1.0));
+  }
+}
+
+void HeatmapItem::Sync(const Frame &frame) {
+  if (image_.isNull())
+    return;
+  const int width = image_.width();
+  const int height = image_.height();
+  const int body_count = frame.positions.size();
+  const int worker_count = pool_.GetThreadCount();
+
+  // Raw pointers are taken first, so workers do not touch shared containers.
+  histograms_.resize(worker_count);
+  QVector<float*> histograms(worker_count);
+  for (int i = 0; i < worker_count; ++i) {
+    histograms_[i].resize(width * height);
+    histograms[i] = histograms_[i].data();
+  }
+  pool_.Run(worker_count, [&](int task, int worker) {
+    Q_UNUSED(worker);
+    std::fill(histograms[task], histograms[task] + width * height, 0.0f);
+  });
+
+  // Every worker sums Bodies into its own histogram.
+  const bool mass_weighted = mass_weighted_;
+  const QPointF *positions = frame.positions.constData();
+  const qreal *masses = frame.masses.constData();
+  const int splat_tasks = (body_count + kBodiesPerTask - 1) / kBodiesPerTask;
+  pool_.Run(splat_tasks, [&](int task, int worker) {
+    float *histogram = histograms[worker];
+    const int begin = task * kBodiesPerTask;
+    const int end = std::min(body_count, begin + kBodiesPerTask);
+    int pixels[kBodiesPerTask];
+    find_pixels_(positions + begin, end - begin, transform_, width, height,
+                 pixels);
+    for (int i = begin; i < end; ++i) {
+      if (pixels[i - begin] >= 0)
+        histogram[pixels[i - begin]] += mass_weighted ? masses[i] : 1.0f;
+    }
+  });
+
+  // Histograms are summed by bands of rows.
+  const int band_tasks = (height + kRowsPerTask - 1) / kRowsPerTask;
+  maxima_.resize(band_tasks);
+  float *maxima = maxima_.data();
+  pool_.Run(band_tasks, [&](int task, int worker) {
+    Q_UNUSED(worker);
+    const int begin = task * kRowsPerTask * width;
+    const int end = std::min(height, (task + 1) * kRowsPerTask) * width;
+    maxima[task] = sum_histograms_(histograms.constData(), worker_count,
+                                   begin, end);
+  });
+  float maximum = 0.0f;
+  for (int i = 0; i < band_tasks; ++i)
+    maximum = std::max(maximum, maxima[i]);
+
+  // Tone mapping in logarithmic scale. Empty pixels stay transparent.
+  const float factor = (palette_.size() - 1) / std::log1p(maximum);
+  const QRgb *palette = palette_.constData();
+  uchar *bits = image_.bits();
+  const int stride = image_.bytesPerLine();
+  pool_.Run(band_tasks, [&](int task, int worker) {
+    Q_UNUSED(worker);
+    const int end = std::min(height, (task + 1) * kRowsPerTask);
+    for (int y = task * kRowsPerTask; y < end; ++y) {
+      QRgb *line = reinterpret_cast<QRgb*>(bits + y * stride);
+      const float *row = histograms[0] + y * width;
+      for (int x = 0; x < width; ++x) {
+        line[x] = row[x] > 0.0f ?
+                  palette[static_cast<int>(std::log1p(row[x]) * factor)] : 0;
+      }
+    }
+  });
+  update();
+}
+
+void HeatmapItem::SetMassWeighted(bool mass_weighted) {
+  mass_weighted_ = mass_weighted;
+}
+
+void HeatmapItem::SetViewTransform(const QTransform &transform,
+                                   const QSize &size) {
+  if (image_.size() != size)
+    image_ = QImage(size, QImage::Format_ARGB32_Premultiplied);
+  transform_ = transform;
+
+  prepareGeometryChange();
+  bounding_rect_ = transform_.inverted().mapRect(QRectF(QPointF(0, 0), size));
+  update();
+}
+
+QRectF HeatmapItem::boundingRect() const {
+  return bounding_rect_;
+}
+
+void HeatmapItem::paint(QPainter *painter,
+                        const QStyleOptionGraphicsItem *option,
+                        QWidget *widget) {
+  Q_UNUSED(option);
+  Q_UNUSED(widget);
+  if (image_.isNull())
+    return;
+  painter->save();
+  painter->resetTransform();
+  painter->drawImage(0, 0, image_);
+  painter->restore();
+}
@@ -0,0 +1,119 @@
+/**
+  ******************************************************************************
+  * @file    heatmap_item.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of HeatmapItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef HEATMAP_ITEM_H
+#define HEATMAP_ITEM_H
+
+#include <QGraphicsItem>
+#include <QImage>
+#include <QTransform>
+#include <QVector>
+
+#include "frame.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Graphics item which shows density of Bodies. Masses or counts of
+  *        Bodies are summed in every pixel of View in parallel and shown in
+  *        logarithmic scale. Used instead of BodiesItem when most Bodies are
+  *        smaller than pixel.
+  */
+class HeatmapItem : public QGraphicsItem {
+ public:
+  // Number of Bodies summed by one task.
+  static constexpr int kBodiesPerTask = 4096;
+  // Number of rows of image processed by one task.
+  static constexpr int kRowsPerTask = 16;
+
+  /**
+    * @brief HeatmapItem constructor.
+    */
+  HeatmapItem();
+
+  /**
+    * @brief Sums Bodies into histogram and creates image from it.
+    * @param frame State of Bodies.
+    */
+  void Sync(const Frame &frame);
+
+  /**
+    * @brief Mass weighting mutator.
+    * @param mass_weighted Should masses of Bodies be summed instead of their
+    *        counts?
+    */
+  void SetMassWeighted(bool mass_weighted);
+
+  /**
+    * @brief Tells item how Scene is mapped into View.
+    * @param transform Transformation from Scene to viewport coordinates.
+    * @param size Size of viewport.
+    */
+  void SetViewTransform(const QTransform &transform, const QSize &size);
+
+  /**
+    * @brief  Bounding rectangle accessor.
+    * @retval Rectangle of Scene visible in View.
+    */
+  QRectF boundingRect() const;
+
+  /**
+    * @brief Draws image in viewport coordinates.
+    * @param painter Painter.
+    * @param option Style options.
+    * @param widget Widget being painted on.
+    */
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+             QWidget *widget);
+
+ private:
+  // Finds index of pixel of each Body, -1 outside image, from positions
+  // of Bodies, their number, transformation to viewport and size of image.
+  typedef void (*PixelFinder)(const QPointF*, int, const QTransform&, int,
+                              int, int*);
+  // Adds histograms to the first one and finds its maximum, from
+  // histograms, their number and range of pixels.
+  typedef float (*HistogramSummer)(float* const*, int, int, int);
+
+  // Kernels compiled for instruction set of processor.
+  PixelFinder find_pixels_;
+  HistogramSummer sum_histograms_;
+  WorkerPool pool_;
+  // Histogram of every worker, summed together into the first one.
+  QVector<QVector<float> > histograms_;
+  // Maximum value of histogram in rows processed by each task.
+  QVector<float> maxima_;
+  // Colours of logarithmic scale.
+  QVector<QRgb> palette_;
+  QImage image_;
+  bool mass_weighted_;
+  QTransform transform_;
+  QRectF bounding_rect_;
+};
+
+#endif // HEATMAP_ITEM_H
@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file    hilbert_curve.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Hilbert curve functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "hilbert_curve.h"
+
+#include <algorithm>
+
+quint32 HilbertIndex(quint32 x, quint32 y) {
+  const quint32 side = 1u << kHilbertOrder;
+  quint32 index = 0;
+  for (quint32 half = side / 2; half > 0; half /= 2) {
+    const quint32 right = (x & half) ? 1 : 0;
+    const quint32 top = (y & half) ? 1 : 0;
+    index += half * half * ((3 * right) ^ top);
+    // Rotates quadrant, so curve inside it starts and ends next to
+    // neighbouring quadrants.
+    if (top == 0) {
+      if (right == 1) {
+        x = side - 1 - x;
+        y = side - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
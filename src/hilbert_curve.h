@@ -0,0 +1,46 @@
+/**
+  ******************************************************************************
+  * @file    hilbert_curve.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of Hilbert curve functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef HILBERT_CURVE_H
+#define HILBERT_CURVE_H
+
+#include <QtGlobal>
+
+// Number of bits of each coordinate on the curve.
+const int kHilbertOrder = 16;
+
+/**
+  * @brief  Finds distance along Hilbert curve filling square grid. Points
+  *         close on the curve are close in space.
+  * @param  x Column in grid, lower than 2^kHilbertOrder.
+  * @param  y Row in grid, lower than 2^kHilbertOrder.
+  * @retval Distance from beginning of the curve.
+  */
+quint32 HilbertIndex(quint32 x, quint32 y);
+
+#endif // HILBERT_CURVE_H
@@ -0,0 +1,126 @@
+/**
+  ******************************************************************************
+  * @file    kepler_drift.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Kepler drift functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "kepler_drift.h"
+
+#include <cmath>
+
+// Largest number of iterations of solver of Kepler equation.
+static const int kMaxIterations = 50;
+
+/**
+  * @brief Finds Stumpff functions c0..c3 of given argument.
+  * @param x Argument, beta * s^2.
+  * @param c Values of c0, c1, c2 and c3.
+  */
+static void Stumpff(qreal x, qreal c[4]) {
+  if (std::fabs(x) < 1.0) {
+    // Series avoid cancellation of formulas below for small arguments.
+    qreal term_2 = 0.5;
+    qreal term_3 = 1.0 / 6.0;
+    c[2] = 0.0;
+    c[3] = 0.0;
+    for (int k = 0; k < 14; ++k) {
+      c[2] += term_2;
+      c[3] += term_3;
+      term_2 *= -x / ((2 * k + 3) * (2 * k + 4));
+      term_3 *= -x / ((2 * k + 4) * (2 * k + 5));
+    }
+    c[1] = 1.0 - x * c[3];
+    c[0] = 1.0 - x * c[2];
+  } else if (x > 0.0) {
+    const qreal root = std::sqrt(x);
+    c[0] = std::cos(root);
+    c[1] = std::sin(root) / root;
+    c[2] = (1.0 - c[0]) / x;
+    c[3] = (1.0 - c[1]) / x;
+  } else {
+    const qreal root = std::sqrt(-x);
+    c[0] = std::cosh(root);
+    c[1] = std::sinh(root) / root;
+    c[2] = (1.0 - c[0]) / x;
+    c[3] = (1.0 - c[1]) / x;
+  }
+}
+
+void KeplerDrift(qreal mu, qreal time, QPointF *position, QPointF *velocity) {
+  const qreal r0 = std::sqrt(position->x() * position->x() +
+                             position->y() * position->y());
+  if (mu <= 0.0 || r0 == 0.0) {
+    *position += *velocity * time;
+    return;
+  }
+  const qreal v0_squared = velocity->x() * velocity->x() +
+                           velocity->y() * velocity->y();
+  const qreal eta = position->x() * velocity->x() +
+                    position->y() * velocity->y();
+  // Positive for elliptic orbits.
+  const qreal beta = 2.0 * mu / r0 - v0_squared;
+  if (beta > 0.0) {
+    // Whole revolutions do not change anything.
+    const qreal period = 2.0 * M_PI * mu / (beta * std::sqrt(beta));
+    time = std::fmod(time, period);
+  }
+
+  // Kepler equation in universal anomaly s is solved with Laguerre method,
+  // which converges from any starting point.
+  qreal s = time / r0;
+  qreal c[4];
+  qreal r = r0;
+  for (int i = 0; i < kMaxIterations; ++i) {
+    const qreal s_squared = s * s;
+    Stumpff(beta * s_squared, c);
+    const qreal g1 = s * c[1];
+    const qreal g2 = s_squared * c[2];
+    const qreal g3 = s_squared * s * c[3];
+    const qreal f = r0 * g1 + eta * g2 + mu * g3 - time;
+    r = r0 * c[0] + eta * g1 + mu * g2;
+    const qreal f_second = eta * c[0] + (mu - beta * r0) * g1;
+    const int n = 5;
+    const qreal root = std::sqrt(std::fabs((n - 1) * (n - 1) * r * r -
+                                           n * (n - 1) * f * f_second));
+    const qreal delta = n * f / (r + (r >= 0.0 ? root : -root));
+    s -= delta;
+    if (std::fabs(delta) <= 1e-15 * std::fabs(s))
+      break;
+  }
+  const qreal s_squared = s * s;
+  Stumpff(beta * s_squared, c);
+  const qreal g1 = s * c[1];
+  const qreal g2 = s_squared * c[2];
+  const qreal g3 = s_squared * s * c[3];
+  r = r0 * c[0] + eta * g1 + mu * g2;
+
+  const qreal f = 1.0 - mu * g2 / r0;
+  const qreal g = time - mu * g3;
+  const qreal f_dot = -mu * g1 / (r0 * r);
+  const qreal g_dot = 1.0 - mu * g2 / r;
+  const QPointF new_position = *position * f + *velocity * g;
+  *velocity = *position * f_dot + *velocity * g_dot;
+  *position = new_position;
+}
@@ -0,0 +1,46 @@
+/**
+  ******************************************************************************
+  * @file    kepler_drift.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of Kepler drift functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef KEPLER_DRIFT_H
+#define KEPLER_DRIFT_H
+
+#include <QPointF>
+
+/**
+  * @brief Moves Body along exact Kepler orbit around fixed center of
+  *        attraction. Works for elliptic, parabolic and hyperbolic orbits,
+  *        using universal variables and Gauss f and g functions.
+  * @param mu Gravitational parameter (gravitational constant multiplied by
+  *        mass of center). Value 0 moves Body along straight line.
+  * @param time Duration of drift.
+  * @param position Position relative to center.
+  * @param velocity Velocity relative to center.
+  */
+void KeplerDrift(qreal mu, qreal time, QPointF *position, QPointF *velocity);
+
+#endif // KEPLER_DRIFT_H
@@ -28,16 +28,327 @@
   */
 
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QDesktopWidget>
+#include <QTextStream>
+#include <QtMath>
+#include <cstring>
+#ifdef HAVE_MPI
+#include <mpi.h>
+#endif
 
+#ifdef HAVE_MPI
+#include "distributed_runner.h"
+#endif
+#include "cpu_features.h"
+#include "ensemble_runner.h"
+#include "frame_exporter.h"
 #include "mainwindow.h"
+#include "presets.h"
+#include "scene.h"
+
+/**
+  * @brief  Runs simulation without window and exports its frames.
+  * @param  parser Parser of command line.
+  * @retval Exit code.
+  */
+static int Export(const QCommandLineParser &parser) {
+  QTextStream err(stderr);
+  int width = 0;
+  int height = 0;
+  QStringList size = parser.value("size").split('x');
+  if (size.count() == 2) {
+    width = size.at(0).toInt();
+    height = size.at(1).toInt();
+  }
+  const int frame_count = parser.value("frames").toInt();
+  const int cadence = parser.value("every").toInt();
+  if (width <= 0 || height <= 0 || frame_count <= 0 || cadence <= 0) {
+    err << "Invalid size, number of frames or cadence." << endl;
+    return 1;
+  }
+
+  Scene scene;
+  Simulation *simulation = scene.simulation_;
+  // Thread which creates pinned pool is pinned too, so pool is created in
+  // thread of simulation, which steps with it.
+  QMetaObject::invokeMethod(simulation, "SetThreadCount",
+                            Qt::BlockingQueuedConnection,
+                            Q_ARG(int, parser.value("threads").toInt()));
+  if (parser.isSet("pin-threads")) {
+    QMetaObject::invokeMethod(simulation, "SetThreadPinning",
+                              Qt::BlockingQueuedConnection,
+                              Q_ARG(bool, true));
+  }
+  simulation->SetDeterministic(parser.isSet("deterministic"));
+  simulation->SetTimeStep(parser.value("time-step").toDouble());
+  simulation->SetTolerance(parser.value("tolerance").toDouble());
+  if (parser.isSet("rk4") || parser.value("method") == "rk4") {
+    simulation->SetMethod(Simulation::kRungeKutta);
+  } else if (parser.value("method") == "wh") {
+    simulation->SetMethod(Simulation::kWisdomHolman);
+  } else if (parser.value("method") == "dopri5") {
+    simulation->SetMethod(Simulation::kDormandPrince);
+  } else if (parser.value("method") != "euler") {
+    err << "Unknown method " << parser.value("method") << "." << endl;
+    return 1;
+  }
+  if (parser.isSet("single"))
+    simulation->SetPrecision(Simulation::kSinglePrecision);
+  if (parser.value("solver") == "tree") {
+    simulation->SetSolver(Simulation::kTree);
+  } else if (parser.value("solver") != "direct") {
+    err << "Unknown solver " << parser.value("solver") << "." << endl;
+    return 1;
+  }
+  if (parser.value("softening") == "plummer") {
+    simulation->SetSoftening(Simulation::kPlummer);
+  } else if (parser.value("softening") == "spline") {
+    simulation->SetSoftening(Simulation::kSpline);
+  } else if (parser.value("softening") != "none") {
+    err << "Unknown softening " << parser.value("softening") << "." << endl;
+    return 1;
+  }
+  if (parser.value("softening-length").toDouble() <= 0.0) {
+    err << "Invalid softening length." << endl;
+    return 1;
+  }
+  simulation->SetSofteningLength(parser.value("softening-length").toDouble());
+  if (parser.value("accuracy").toDouble() <= 0.0) {
+    err << "Invalid accuracy." << endl;
+    return 1;
+  }
+  simulation->SetTuningAccuracy(parser.value("accuracy").toDouble());
+  simulation->SetAutoTune(parser.isSet("autotune"));
+  scene.SetTrails(parser.isSet("trails"));
+  scene.SetLongExposure(parser.isSet("long-exposure"));
+  int zoom;
+  if (parser.value("preset") == "solar") {
+    simulation->AddBodies(CreateSolarSystem());
+    zoom = kSolarSystemZoom;
+  } else if (parser.value("preset") == "protodisk") {
+    simulation->AddBodies(CreateProtodisk(parser.value("bodies").toInt(),
+                                          parser.isSet("test-particles")));
+    zoom = kProtodiskZoom;
+  } else {
+    err << "Unknown preset " << parser.value("preset") << "." << endl;
+    return 1;
+  }
+  if (parser.isSet("zoom"))
+    zoom = parser.value("zoom").toInt();
+  if (parser.isSet("snapshots") &&
+      !simulation->SetSnapshots(parser.value("snapshots"))) {
+    err << "Could not publish snapshots." << endl;
+    return 1;
+  }
+
+  // Zoom is in logarithmic scale, as zoom slider.
+  FrameExporter exporter(&scene, parser.value("export"),
+                         QSize(width, height), qPow(10.0, zoom / 100.0),
+                         parser.value("encoders").toInt());
+  if (!exporter.Run(frame_count, cadence)) {
+    err << "Could not write frames to " << parser.value("export") << "."
+        << endl;
+    return 1;
+  }
+  if (parser.isSet("numa-report")) {
+    QTextStream out(stdout);
+    const QVector<qint64> node_bytes = simulation->GetNodeBytes();
+    for (int node = 0; node < node_bytes.size(); ++node)
+      out << "Node " << node << ": "
+          << QString::number(node_bytes.at(node) / 1048576.0, 'f', 1)
+          << " MB of force arrays" << endl;
+  }
+  return 0;
+}
+
+/**
+  * @brief  Runs ensemble of simulations without window and writes their
+  *         results.
+  * @param  parser Parser of command line.
+  * @retval Exit code.
+  */
+static int RunEnsemble(const QCommandLineParser &parser) {
+  QTextStream err(stderr);
+  EnsembleRunner runner(parser.value("threads").toInt());
+  QString error;
+  if (!runner.Load(parser.value("ensemble"), &error)) {
+    err << error << endl;
+    return 1;
+  }
+  runner.Run();
+  if (!runner.Save(parser.value("results"))) {
+    err << "Could not write results to " << parser.value("results") << "."
+        << endl;
+    return 1;
+  }
+  return 0;
+}
+
+#ifdef HAVE_MPI
+/**
+  * @brief  Runs one simulation split between processes started by mpirun
+  *         and writes summary of each process.
+  * @param  parser Parser of command line.
+  * @retval Exit code.
+  */
+static int RunDistributed(const QCommandLineParser &parser) {
+  QTextStream err(stderr);
+  EnsembleRunner::Scenario scenario;
+  scenario.name = "distributed";
+  scenario.preset = parser.value("preset");
+  scenario.bodies = parser.value("bodies").toInt();
+  scenario.test_particles = parser.isSet("test-particles");
+  scenario.perturbation = 0.0;
+  scenario.seed = 1;
+  scenario.steps = parser.value("steps").toInt();
+  scenario.time_step = parser.value("time-step").toDouble();
+  scenario.tolerance = Simulation::kDefaultTolerance;
+  scenario.single_precision = parser.isSet("single");
+  scenario.solver = Simulation::kTree;
+  scenario.softening_length = parser.value("softening-length").toDouble();
+  scenario.autotune = false;
+  scenario.accuracy = AutoTuner::kDefaultAccuracy;
+  // Adaptive and Wisdom-Holman methods need all Bodies in one place.
+  if (parser.isSet("rk4") || parser.value("method") == "rk4") {
+    scenario.method = Simulation::kRungeKutta;
+  } else if (parser.value("method") == "euler") {
+    scenario.method = Simulation::kEuler;
+  } else {
+    err << "Distributed simulation supports only euler and rk4 methods."
+        << endl;
+    return 1;
+  }
+  if (parser.value("softening") == "none") {
+    scenario.softening = Simulation::kCutoff;
+  } else if (parser.value("softening") == "plummer") {
+    scenario.softening = Simulation::kPlummer;
+  } else if (parser.value("softening") == "spline") {
+    scenario.softening = Simulation::kSpline;
+  } else {
+    err << "Unknown softening " << parser.value("softening") << "." << endl;
+    return 1;
+  }
+  if ((scenario.preset != "solar" && scenario.preset != "protodisk") ||
+      scenario.steps < 0 || scenario.time_step <= 0.0 ||
+      scenario.softening_length <= 0.0) {
+    err << "Invalid preset, number of steps, time step or softening length."
+        << endl;
+    return 1;
+  }
+
+  MPI_Init(NULL, NULL);
+  bool saved;
+  {
+    DistributedRunner runner(parser.value("threads").toInt());
+    runner.Run(scenario);
+    saved = runner.Save(parser.value("results"));
+  }
+  MPI_Finalize();
+  if (!saved) {
+    err << "Could not write results to " << parser.value("results") << "."
+        << endl;
+    return 1;
+  }
+  return 0;
+}
+#endif
 
 /**
   * @brief  Main function.
   * @retval Value thas was set to exit().
   */
 int main(int argc, char *argv[]) {
+  // Export, ensemble and distributed simulation do not show any window, so
+  // they do not need display.
+  for (int i = 1; i < argc; ++i) {
+    if ((strcmp(argv[i], "--export") == 0 ||
+         strcmp(argv[i], "--ensemble") == 0 ||
+         strcmp(argv[i], "--distributed") == 0) &&
+        qgetenv("QT_QPA_PLATFORM").isEmpty())
+      qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
   QApplication a(argc, argv);
+
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  parser.addOptions({
+      {"export", "Export frames without window into <directory>.",
+       "directory"},
+      {"frames", "Number of exported frames.", "count", "1000"},
+      {"every", "Number of steps between exported frames.", "steps", "1"},
+      {"size", "Size of exported frames.", "WxH", "1920x1080"},
+      {"preset", "Exported preset: solar or protodisk.", "name", "protodisk"},
+      {"bodies", "Number of objects in protodisk.", "count",
+       QString::number(kProtodiskBodies)},
+      {"test-particles", "Objects in protodisk are pulled only by "
+       "protostar."},
+      {"zoom", "Zoom in logarithmic scale, as zoom slider.", "value"},
+      {"time-step", "Time step of simulation.", "value", "0.01"},
+      {"method", "Method of integration: euler, rk4, wh (Wisdom-Holman, "
+       "for planetary systems) or dopri5 (adaptive Dormand-Prince).", "name",
+       "euler"},
+      {"tolerance", "Tolerance of adaptive method.", "value",
+       QString::number(Simulation::kDefaultTolerance)},
+      {"rk4", "Use Runge-Kutta method instead of Euler."},
+      {"single", "Sum gravitational forces in single precision."},
+      {"solver", "Summing of gravitational forces: direct (every pair) or "
+       "tree (Barnes-Hut, for many bodies).", "name", "direct"},
+      {"softening", "Softening of gravity: none (cut off at short "
+       "distance), plummer or spline.", "name", "none"},
+      {"softening-length", "Softening length of plummer and spline "
+       "softening.", "value",
+       QString::number(Simulation::kDefaultSofteningLength)},
+      {"threads", "Number of threads summing forces or running ensemble.",
+       "count", "0"},
+      {"pin-threads", "Pin threads summing forces to processor cores and "
+       "place their bodies in memory of their NUMA nodes."},
+      {"numa-report", "Print memory of force arrays on each NUMA node "
+       "after export."},
+      {"isa", "Instruction set of kernels: baseline, avx2 or avx512. The "
+       "newest one supported by processor by default.", "name",
+       NameOfInstructionSet(GetSupportedInstructionSet())},
+      {"autotune", "Choose solver, precision and number of threads by "
+       "timing them on simulated objects."},
+      {"accuracy", "Largest relative error of forces accepted by automatic "
+       "tuning.", "value", QString::number(AutoTuner::kDefaultAccuracy)},
+      {"deterministic", "Merge bodies reproducibly and write hash of state "
+       "of every frame into state_hashes.txt."},
+      {"trails", "Draw trails behind bodies."},
+      {"long-exposure", "Draw fading traces of bodies."},
+      {"encoders", "Number of threads encoding PNG files.", "count", "0"},
+      {"snapshots", "Publish snapshots into shared memory <name>.", "name"},
+      {"ensemble", "Run simulations listed in <file> without window, one "
+       "per thread.", "file"},
+      {"results", "File with results of ensemble or distributed simulation.",
+       "file", "results.csv"}});
+#ifdef HAVE_MPI
+  parser.addOptions({
+      {"distributed", "Run one simulation split between processes started "
+       "by mpirun, without window."},
+      {"steps", "Number of steps of distributed simulation.", "count",
+       "1000"}});
+#endif
+  parser.process(a);
+  // Kernels are chosen when objects which use them are created, so
+  // instruction set is set first.
+  InstructionSet instruction_set;
+  if (!InstructionSetOfName(parser.value("isa"), &instruction_set) ||
+      !SetInstructionSet(instruction_set)) {
+    QTextStream err(stderr);
+    err << "Instruction set " << parser.value("isa")
+        << " is unknown or not supported." << endl;
+    return 1;
+  }
+  if (parser.isSet("export"))
+    return Export(parser);
+  if (parser.isSet("ensemble"))
+    return RunEnsemble(parser);
+#ifdef HAVE_MPI
+  if (parser.isSet("distributed"))
+    return RunDistributed(parser);
+#endif
+
   int width = QApplication::desktop()->width();
   int height = QApplication::desktop()->height();
   MainWindow w;
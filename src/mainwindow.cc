@@ -29,12 +29,22 @@
 
 #include "mainwindow.h"
 
+#include <QInputDialog>
 #include <QMenuBar>
+#include <QMessageBox>
 #include <QTime>
 
+#include "cpu_features.h"
+#include "presets.h"
+
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
-      current_scale_(1) {
+      current_scale_(1),
+      adaptive_(false),
+      time_value_(kDefaultTimeValue),
+      tolerance_value_(kDefaultToleranceValue),
+      trail_length_(Body::kDefaultTrailLength),
+      softening_length_(Simulation::kDefaultSofteningLength) {
   QTime time = QTime::currentTime();
   qsrand(time.msec());
 
@@ -52,8 +62,9 @@ MainWindow::MainWindow(QWidget *parent)
   view_->SetZoomSlider(zoom_slider_);
   ChangeMass(1.0);
   ChangeDensity(1000.0);
-  ChangeTime(10);
+  ChangeTime(kDefaultTimeValue);
   Zoom(0);
+  UpdateMemory();
 }
 
 MainWindow::~MainWindow() {
@@ -71,6 +82,10 @@ MainWindow::~MainWindow() {
   delete density_label_;
   delete radius_label_;
   delete time_label_;
+  delete memory_label_;
+  delete tuning_label_;
+  delete kernels_label_;
+  delete memory_timer_;
   delete button_layout_;
   delete main_layout_;
   delete view_;
@@ -80,9 +95,28 @@ MainWindow::~MainWindow() {
   delete load_proto_action_;
   delete options_action_group_;
   delete set_trails_action_;
+  delete set_trail_length_action_;
+  delete set_exposure_action_;
+  delete set_heatmap_action_;
+  delete set_heatmap_mass_action_;
+  delete set_snapshots_action_;
   delete set_aa_action_;
   delete set_euler_action_;
   delete set_rk4_action_;
+  delete set_wh_action_;
+  delete set_dopri_action_;
+  delete precision_action_group_;
+  delete set_double_action_;
+  delete set_single_action_;
+  delete set_tree_action_;
+  delete set_autotune_action_;
+  delete softening_action_group_;
+  delete set_cutoff_action_;
+  delete set_plummer_action_;
+  delete set_spline_action_;
+  delete set_softening_length_action_;
+  delete set_deterministic_action_;
+  delete set_test_particle_action_;
   delete pause_shortcut_;
   delete file_menu_;
   delete options_menu_;
@@ -94,10 +128,11 @@ void MainWindow::SceneAndViewInit() {
   view_ = new View(this);
   view_->setScene(scene_);
   view_->setRenderHints(QPainter::Antialiasing);
-  view_->setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
-
-  // Remove unnecessary object which was created earlier.
-  scene_->removeItem(scene_->items().at(0));
+  // Scene invalidates only regions of items which changed, so slider and
+  // label updates do not repaint whole viewport.
+  view_->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+  connect(view_, SIGNAL(TransformChanged()),
+          this, SLOT(UpdateViewTransform()));
 }
 
 void MainWindow::MenuInit() {
@@ -136,6 +171,43 @@ void MainWindow::OptionsMenuInit() {
   set_trails_action_->setCheckable(true);
   connect(set_trails_action_, SIGNAL(triggered()), this, SLOT(SetTrails()));
 
+  set_trail_length_action_ = new QAction("Trail &length...", this);
+  options_menu_->addAction(set_trail_length_action_);
+  connect(set_trail_length_action_, SIGNAL(triggered()),
+          this, SLOT(ChangeTrailLength()));
+
+  set_exposure_action_ = new QAction("Long &exposure", this);
+  options_menu_->addAction(set_exposure_action_);
+  set_exposure_action_->setCheckable(true);
+  connect(set_exposure_action_, SIGNAL(triggered()),
+          this, SLOT(SetLongExposure()));
+
+  set_heatmap_action_ = new QAction("Density &heatmap when zoomed out", this);
+  options_menu_->addAction(set_heatmap_action_);
+  set_heatmap_action_->setCheckable(true);
+  set_heatmap_action_->setChecked(true);
+  connect(set_heatmap_action_, SIGNAL(triggered()), this, SLOT(SetHeatmap()));
+
+  set_heatmap_mass_action_ = new QAction("Heatmap of &mass", this);
+  options_menu_->addAction(set_heatmap_mass_action_);
+  set_heatmap_mass_action_->setCheckable(true);
+  connect(set_heatmap_mass_action_, SIGNAL(triggered()),
+          this, SLOT(SetHeatmapMass()));
+
+  set_test_particle_action_ = new QAction("Create test &particles", this);
+  options_menu_->addAction(set_test_particle_action_);
+  set_test_particle_action_->setCheckable(true);
+  connect(set_test_particle_action_, SIGNAL(triggered()),
+          this, SLOT(SetTestParticle()));
+
+  set_snapshots_action_ = new QAction("Publish &snapshots", this);
+  options_menu_->addAction(set_snapshots_action_);
+  set_snapshots_action_->setCheckable(true);
+  connect(set_snapshots_action_, SIGNAL(triggered()),
+          this, SLOT(SetSnapshots()));
+  connect(scene_->simulation_, SIGNAL(SnapshotsFailed()),
+          this, SLOT(ShowSnapshotsError()));
+
   set_aa_action_ = new QAction("&Antialiasing", this);
   options_menu_->addAction(set_aa_action_);
   set_aa_action_->setCheckable(true);
@@ -156,6 +228,86 @@ void MainWindow::OptionsMenuInit() {
   set_rk4_action_->setCheckable(true);
   options_action_group_->addAction(set_rk4_action_);
   connect(set_rk4_action_, SIGNAL(triggered()), this, SLOT(SetRK4()));
+
+  set_wh_action_ = new QAction("&Wisdom-Holman (planetary)", this);
+  options_menu_->addAction(set_wh_action_);
+  set_wh_action_->setCheckable(true);
+  options_action_group_->addAction(set_wh_action_);
+  connect(set_wh_action_, SIGNAL(triggered()),
+          this, SLOT(SetWisdomHolman()));
+
+  set_dopri_action_ = new QAction("&Dormand-Prince 5(4) (adaptive)", this);
+  options_menu_->addAction(set_dopri_action_);
+  set_dopri_action_->setCheckable(true);
+  options_action_group_->addAction(set_dopri_action_);
+  connect(set_dopri_action_, SIGNAL(triggered()),
+          this, SLOT(SetDormandPrince()));
+
+  options_menu_->addSeparator();
+  precision_action_group_ = new QActionGroup(this);
+
+  set_double_action_ = new QAction("&Double precision", this);
+  options_menu_->addAction(set_double_action_);
+  set_double_action_->setCheckable(true);
+  set_double_action_->setChecked(true);
+  precision_action_group_->addAction(set_double_action_);
+  connect(set_double_action_, SIGNAL(triggered()),
+          this, SLOT(SetDoublePrecision()));
+
+  set_single_action_ = new QAction("&Single precision (faster)", this);
+  options_menu_->addAction(set_single_action_);
+  set_single_action_->setCheckable(true);
+  precision_action_group_->addAction(set_single_action_);
+  connect(set_single_action_, SIGNAL(triggered()),
+          this, SLOT(SetSinglePrecision()));
+
+  set_tree_action_ = new QAction("&Barnes-Hut tree (many objects)", this);
+  options_menu_->addAction(set_tree_action_);
+  set_tree_action_->setCheckable(true);
+  connect(set_tree_action_, SIGNAL(triggered()), this, SLOT(SetTree()));
+
+  set_autotune_action_ = new QAction("A&utomatic tuning", this);
+  options_menu_->addAction(set_autotune_action_);
+  set_autotune_action_->setCheckable(true);
+  connect(set_autotune_action_, SIGNAL(triggered()),
+          this, SLOT(SetAutoTune()));
+
+  options_menu_->addSeparator();
+  softening_action_group_ = new QActionGroup(this);
+
+  set_cutoff_action_ = new QAction("&No softening", this);
+  options_menu_->addAction(set_cutoff_action_);
+  set_cutoff_action_->setCheckable(true);
+  set_cutoff_action_->setChecked(true);
+  softening_action_group_->addAction(set_cutoff_action_);
+  connect(set_cutoff_action_, SIGNAL(triggered()),
+          this, SLOT(SetCutoff()));
+
+  set_plummer_action_ = new QAction("&Plummer softening", this);
+  options_menu_->addAction(set_plummer_action_);
+  set_plummer_action_->setCheckable(true);
+  softening_action_group_->addAction(set_plummer_action_);
+  connect(set_plummer_action_, SIGNAL(triggered()),
+          this, SLOT(SetPlummer()));
+
+  set_spline_action_ = new QAction("Spli&ne softening", this);
+  options_menu_->addAction(set_spline_action_);
+  set_spline_action_->setCheckable(true);
+  softening_action_group_->addAction(set_spline_action_);
+  connect(set_spline_action_, SIGNAL(triggered()),
+          this, SLOT(SetSpline()));
+
+  set_softening_length_action_ = new QAction("Softening len&gth...", this);
+  options_menu_->addAction(set_softening_length_action_);
+  connect(set_softening_length_action_, SIGNAL(triggered()),
+          this, SLOT(ChangeSofteningLength()));
+
+  options_menu_->addSeparator();
+  set_deterministic_action_ = new QAction("De&terministic", this);
+  options_menu_->addAction(set_deterministic_action_);
+  set_deterministic_action_->setCheckable(true);
+  connect(set_deterministic_action_, SIGNAL(triggered()),
+          this, SLOT(SetDeterministic()));
 }
 
 void MainWindow::SlidersInit() {
@@ -182,9 +334,19 @@ void MainWindow::SlidersInit() {
 
   time_slider_ = new QSlider(Qt::Horizontal, view_);
   time_slider_->setRange(1, 50);
-  time_slider_->setValue(10);
+  time_slider_->setValue(kDefaultTimeValue);
   connect(time_slider_, SIGNAL(valueChanged(int)), this, SLOT(ChangeTime(int)));
   time_label_ = new QLabel("", view_);
+
+  memory_label_ = new QLabel("", view_);
+  tuning_label_ = new QLabel("", view_);
+  kernels_label_ = new QLabel("<font color='white'>Kernels: " +
+                              NameOfInstructionSet(GetInstructionSet()) +
+                              "</font>", view_);
+  memory_timer_ = new QTimer(this);
+  connect(memory_timer_, SIGNAL(timeout()), this, SLOT(UpdateMemory()));
+  connect(memory_timer_, SIGNAL(timeout()), this, SLOT(UpdateTuning()));
+  memory_timer_->start(kMemoryInterval);
 }
 
 void MainWindow::ButtonsInit() {
@@ -247,60 +409,14 @@ void MainWindow::LayoutInit() {
   main_layout_->addWidget(radius_label_, 5, 0, 1, 1, Qt::AlignHCenter);
   main_layout_->addWidget(time_label_, 7, 0, 1, 1);
   main_layout_->addWidget(time_slider_, 8, 0, 1, 1, Qt::AlignLeft);
-}
-
-int MainWindow::RandInt(int low, int high) const {
-  return qrand() % ((high + 1) - low) + low;
-}
-
-Body *MainWindow::AddPlanet(qreal mass, qreal density, qreal semi_major_axis,
-                            qreal eccentricity, qreal angle) {
-  // Calculations of proper velocity and position of planet which will create
-  // desired orbit around Sun.
-  qreal velocity = scene_->kGravConstant * 1989100 * (1 + eccentricity);
-  velocity /= semi_major_axis * 100 * (1 - eccentricity);
-  velocity = sqrt(velocity);
-  qreal position = semi_major_axis * 100 * (1 - eccentricity);
-  qreal angle_rad = angle * M_PI / 180;
-  Body *body = new Body(mass, 10 * cbrt(mass / (density * 4.189)),
-                        -velocity * sin(angle_rad), velocity * cos(angle_rad),
-                        position * cos(angle_rad), position * sin(angle_rad));
-  scene_->addItem(body);
-  scene_->body_list_.append(body);
-  if (scene_->trails_)
-    body->CreateTrails(current_scale_);
-  return body;
-}
-
-void MainWindow::AddMoon(const Body *planet, qreal mass, qreal density,
-                         qreal semi_major_axis, qreal eccentricity,
-                         qreal angle) {
-  // Calculations of proper velocity and position of moon which will create
-  // desired orbit around planet.
-  qreal velocity = scene_->kGravConstant;
-  velocity *= planet->GetMass() * (1 + eccentricity);
-  velocity /= semi_major_axis * 100 * (1  -eccentricity);
-  velocity = sqrt(velocity);
-  qreal position = semi_major_axis * 100 * (1 - eccentricity);
-  qreal angle_rad = angle * M_PI / 180;
-  Body *body = new Body(mass, 10 * cbrt(mass / (density * 4.189)),
-                        -velocity * sin(angle_rad) + planet->GetVelocity().x(),
-                        velocity * cos(angle_rad) + planet->GetVelocity().y(),
-                        position * cos(angle_rad) + planet->pos().x(),
-                        position * sin(angle_rad) + planet->pos().y());
-  scene_->addItem(body);
-  scene_->body_list_.append(body);
-  if (scene_->trails_)
-    body->CreateTrails(current_scale_);
+  main_layout_->addWidget(memory_label_, 9, 0, 1, 1);
+  main_layout_->addWidget(tuning_label_, 10, 0, 1, 1);
+  main_layout_->addWidget(kernels_label_, 11, 0, 1, 1);
 }
 
 void MainWindow::DeleteAll() {
-  foreach (Body* body, scene_->body_list_) {
-    body->DeleteTrails();
-    scene_->removeItem(body);
-    scene_->body_list_.clear();
-    delete body;
-  }
+  QMetaObject::invokeMethod(scene_->simulation_, "Clear",
+                            Qt::QueuedConnection);
   zoom_slider_->setValue(0);
   view_->centerOn(0, 0);
 }
@@ -308,112 +424,75 @@ void MainWindow::DeleteAll() {
 void MainWindow::LoadSolarSystem() {
   // Initialize scene.
   DeleteAll();
-  zoom_slider_->setValue(-100);
+  zoom_slider_->setValue(kSolarSystemZoom);
   set_trails_action_->setChecked(true);
   SetTrails();
-
-  // Add Sun.
-  Body *body = new Body(1989100.0, 10 * cbrt(1989100 / (1409 * 4.189)),
-                        0.0, 0.0, 0.0, 0.0);
-  scene_->addItem(body);
-  scene_->body_list_.append(body);
-  if (scene_->trails_)
-    body->CreateTrails(current_scale_);
-
-  // Add planets and moons.
-  body = AddPlanet(0.3301, 5427, 57.909227, 0.20563593, 48.331);     // Mercury
-  body = AddPlanet(4.8673, 5243, 108.20948, 0.00677672, 76.678);     // Venus
-  body = AddPlanet(5.9722, 5513, 149.59826, 0.01671123, 348.73936);  // Earth
-  AddMoon(body, 0.073477, 3346, 0.384399, 0.0549, 125.08);  // Moon
-  body = AddPlanet(0.64169, 3934, 227.94382, 0.0933941, 49.562);     // Mars
-  body = AddPlanet(1898.1, 1326, 778.34082, 0.04838624, 100.492);    // Jupiter
-  AddMoon(body, 0.0894, 3528, 0.4216, 0.0041, 0);           // Io
-  AddMoon(body, 0.048, 3010, 0.6709, 0.009, 0);             // Europa
-  AddMoon(body, 0.14819, 1936, 1.0704, 0.0013, 0);          // Ganymede
-  AddMoon(body, 0.10758, 1830, 1.8827, 0.0074, 0);          // Callisto
-  body = AddPlanet(568.32, 687, 1426.6664, 0.05386179, 113.643);     // Saturn
-  AddMoon(body, 0.0000375, 1150, 0.18552, 0.0202, 0);       // Mimas
-  AddMoon(body, 0.000108, 1610, 0.237948, 0.0047, 0);       // Enceladus
-  AddMoon(body, 0.0006174, 980, 0.294619, 0.02, 0);         // Tethys
-  AddMoon(body, 0.001095, 1480, 0.377396, 0.002, 0);        // Dione
-  AddMoon(body, 0.002306, 1230, 0.527108, 0.001, 0);        // Rhea
-  AddMoon(body, 0.13452, 1880, 1.22187, 0.0288, 0);         // Titan
-  AddMoon(body, 0.0018053, 1080, 3.56082, 0.0286, 0);       // Iapetus
-  body = AddPlanet(86.81, 1270, 2870.6582, 0.04725744, 73.99);       // Uranus
-  AddMoon(body, 0.0000659, 1200, 0.12939, 0.0013, 0);       // Miranda
-  AddMoon(body, 0.00135, 1670, 0.1909, 0.0012, 0);          // Ariel
-  AddMoon(body, 0.0012, 1400, 0.2662, 0.005, 0);            // Umbriel
-  AddMoon(body, 0.0035, 1720, 0.4363, 0.0011, 0);           // Titania
-  AddMoon(body, 0.003014, 1630, 0.583519, 0.0014, 0);       // Oberon
-  body = AddPlanet(102.41, 1638, 4498.3964, 0.00859048, 131.794);    // Neptune
-  AddMoon(body, 0.0214, 2061, 0.354759, 0.00002, 0);        // Triton
+  QMetaObject::invokeMethod(scene_->simulation_, "AddBodies",
+                            Qt::QueuedConnection,
+                            Q_ARG(QList<Body*>, CreateSolarSystem()));
 }
 
 void MainWindow::LoadProtodisk() {
   // Initialize scene.
   DeleteAll();
-  zoom_slider_->setValue(-70);
+  zoom_slider_->setValue(kProtodiskZoom);
   set_trails_action_->setChecked(false);
   SetTrails();
-  qreal mass;
-  qreal radius;
-  qreal density;
-  Body *body;
-
-  // Add protostar.
-  mass = 1000000;
-  density = 6000;
-  radius = 100.0 * cbrt(mass / (density * 4.189));
-  body = new Body(mass, radius, 0.0, 0.0, 0.0, 0.0);
-  scene_->addItem(body);
-  scene_->body_list_.append(body);
-  if (scene_->trails_)
-    body->CreateTrails(current_scale_);
-
-  // Add protodisk objects.
-  mass = 1;
-  density = 500;
-  radius = 100.0 * cbrt(mass / (density * 4.189));
-  for (int i = 0; i < 1000; ++i) {
-    qreal min_disk_radius_squared = 250000.0;
-    qreal max_disk_radius_squared = 2250000.0;
-    qreal disk_radius = RandInt(0, 1000) * 0.001;
-    disk_radius *= max_disk_radius_squared - min_disk_radius_squared;
-    disk_radius += min_disk_radius_squared;
-    disk_radius = sqrt(disk_radius);
-    qreal disk_angle = RandInt(0, 3600) * 0.1 * M_PI / 180.0;
-    qreal body_vel_x = -sqrt(6673850000.0 / disk_radius) * sin(disk_angle);
-    qreal body_vel_y = sqrt(6673850000.0 / disk_radius) * cos(disk_angle);
-    qreal body_pos_x = disk_radius * cos(disk_angle);
-    qreal body_pos_y = disk_radius * sin(disk_angle);
-    body = new Body(mass, radius,
-                    body_vel_x, body_vel_y, body_pos_x, body_pos_y);
-    scene_->addItem(body);
-    scene_->body_list_.append(body);
-    if (scene_->trails_)
-      body->CreateTrails(current_scale_);
-  }
+  QMetaObject::invokeMethod(scene_->simulation_, "AddBodies",
+                            Qt::QueuedConnection,
+                            Q_ARG(QList<Body*>, CreateProtodisk()));
 }
 
 void MainWindow::SetTrails() {
-  if (set_trails_action_->isChecked()) {
-    scene_->trails_ = true;
-    foreach (Body *body, scene_->body_list_)
-      body->CreateTrails(current_scale_);
-  } else {
-    scene_->trails_ = false;
-    foreach (Body *body, scene_->body_list_)
-      body->DeleteTrails();
+  scene_->SetTrails(set_trails_action_->isChecked());
+}
+
+void MainWindow::ChangeTrailLength() {
+  bool ok;
+  int length = QInputDialog::getInt(this, "Trail length",
+                                    "Positions remembered in trail:",
+                                    trail_length_, 2, 10000, 1, &ok);
+  if (ok) {
+    trail_length_ = length;
+    QMetaObject::invokeMethod(scene_->simulation_, "SetTrailLength",
+                              Qt::QueuedConnection, Q_ARG(int, length));
   }
 }
 
+void MainWindow::SetLongExposure() {
+  scene_->SetLongExposure(set_exposure_action_->isChecked());
+}
+
+void MainWindow::SetHeatmap() {
+  scene_->SetAutoHeatmap(set_heatmap_action_->isChecked());
+}
+
+void MainWindow::SetHeatmapMass() {
+  scene_->SetHeatmapMassWeighted(set_heatmap_mass_action_->isChecked());
+}
+
+void MainWindow::SetSnapshots() {
+  const QString name = set_snapshots_action_->isChecked()
+                           ? QString(SNAPSHOT_DEFAULT_NAME)
+                           : QString();
+  QMetaObject::invokeMethod(scene_->simulation_, "SetSnapshots",
+                            Qt::QueuedConnection, Q_ARG(QString, name));
+}
+
+void MainWindow::ShowSnapshotsError() {
+  set_snapshots_action_->setChecked(false);
+  QMessageBox::warning(this, "Snapshots",
+                       "Could not create shared memory object.");
+}
+
+void MainWindow::UpdateViewTransform() {
+  scene_->SetViewTransform(view_->viewportTransform(),
+                           view_->viewport()->size());
+}
+
 void MainWindow::SetAntialiasing() {
+  // Sprites of Bodies are rendered again when antialiasing changes.
   view_->setRenderHint(QPainter::Antialiasing, set_aa_action_->isChecked());
-  foreach (Body *body, scene_->body_list_) {
-    // Cache has to be reset.
-    body->setCacheMode(QGraphicsItem::NoCache);
-    body->setCacheMode(QGraphicsItem::DeviceCoordinateCache);
-  }
 }
 
 void MainWindow::Zoom(int value) {
@@ -421,17 +500,16 @@ void MainWindow::Zoom(int value) {
   qreal scale = pow(10.0, value / 100.0);
   view_->scale(scale / current_scale_, scale / current_scale_);
   current_scale_ = scale;
-  scene_->view_scale_ = current_scale_;
+  scene_->SetViewScale(current_scale_);
   QString label_text = "<font color='white'>Zoom: ";
   label_text += QString::number(current_scale_);
   label_text += "</font>";
   zoom_label_->setText(label_text);
-  // Change size of creation line and trails in Scene,
-  // so their visible size stays the same.
+  // Change size of creation line in Scene, so its visible size stays the
+  // same. Trails are drawn with cosmetic pen.
   scene_->creation_line_->setPen(QPen(Qt::white, 1 / current_scale_));
-  foreach (Body *body, scene_->body_list_)
-    foreach (QGraphicsLineItem *line, body->trails_)
-      line->setPen(QPen(Qt::white, 0.25 / current_scale_));
+  // Long exposure image is no longer valid.
+  UpdateViewTransform();
 }
 
 void MainWindow::ChangeMass(int value) {
@@ -465,20 +543,42 @@ void MainWindow::ChangeRadius() {
 }
 
 void MainWindow::ChangeTime(int value) {
-  scene_->SetTimeStep(value / 1000.0);
-  QString label_text = "<font color='white'>Time step: ";
-  label_text += QString::number(value / 1000.0);
+  QString label_text;
+  if (adaptive_) {
+    tolerance_value_ = value;
+    qreal tolerance = pow(10.0, -value / 5.0);
+    QMetaObject::invokeMethod(scene_->simulation_, "SetTolerance",
+                              Qt::QueuedConnection, Q_ARG(qreal, tolerance));
+    label_text = "<font color='white'>Tolerance: ";
+    label_text += QString::number(tolerance, 'g', 2);
+  } else {
+    time_value_ = value;
+    QMetaObject::invokeMethod(scene_->simulation_, "SetTimeStep",
+                              Qt::QueuedConnection,
+                              Q_ARG(qreal, value / 1000.0));
+    label_text = "<font color='white'>Time step: ";
+    label_text += QString::number(value / 1000.0);
+  }
   label_text += "</font>";
   time_label_->setText(label_text);
 }
 
+void MainWindow::SetAdaptive(bool adaptive) {
+  if (adaptive == adaptive_)
+    return;
+  adaptive_ = adaptive;
+  int value = adaptive_ ? tolerance_value_ : time_value_;
+  // Slider does not emit signal if its position does not change.
+  time_slider_->blockSignals(true);
+  time_slider_->setValue(value);
+  time_slider_->blockSignals(false);
+  ChangeTime(value);
+}
+
 void MainWindow::ButtonClicked(bool check) {
   QObject* obj = sender();
   if (obj == pause_button_) {
-    if (check)
-      scene_->advancing_timer_->stop();
-    else
-      scene_->advancing_timer_->start(10);
+    scene_->simulation_->SetPaused(check);
 
   } else if (obj == drag_button_) {
     if (check) {
@@ -501,9 +601,151 @@ void MainWindow::ButtonClicked(bool check) {
 }
 
 void MainWindow::SetEuler() {
-  scene_->runge_kutta_ = false;
+  QMetaObject::invokeMethod(scene_->simulation_, "SetMethod",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Method,
+                                  Simulation::kEuler));
+  SetAdaptive(false);
 }
 
 void MainWindow::SetRK4() {
-  scene_->runge_kutta_ = true;
+  QMetaObject::invokeMethod(scene_->simulation_, "SetMethod",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Method,
+                                  Simulation::kRungeKutta));
+  SetAdaptive(false);
+}
+
+void MainWindow::SetWisdomHolman() {
+  QMetaObject::invokeMethod(scene_->simulation_, "SetMethod",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Method,
+                                  Simulation::kWisdomHolman));
+  SetAdaptive(false);
+}
+
+void MainWindow::SetDormandPrince() {
+  QMetaObject::invokeMethod(scene_->simulation_, "SetMethod",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Method,
+                                  Simulation::kDormandPrince));
+  SetAdaptive(true);
+}
+
+void MainWindow::SetDoublePrecision() {
+  QMetaObject::invokeMethod(scene_->simulation_, "SetPrecision",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Precision,
+                                  Simulation::kDoublePrecision));
+}
+
+void MainWindow::SetSinglePrecision() {
+  QMetaObject::invokeMethod(scene_->simulation_, "SetPrecision",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Precision,
+                                  Simulation::kSinglePrecision));
+}
+
+void MainWindow::SetTree() {
+  const Simulation::Solver solver = set_tree_action_->isChecked()
+                                        ? Simulation::kTree
+                                        : Simulation::kDirect;
+  QMetaObject::invokeMethod(scene_->simulation_, "SetSolver",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Solver, solver));
+}
+
+void MainWindow::SetAutoTune() {
+  const bool autotune = set_autotune_action_->isChecked();
+  QMetaObject::invokeMethod(scene_->simulation_, "SetAutoTune",
+                            Qt::QueuedConnection, Q_ARG(bool, autotune));
+  // Tuner overrides these choices, so they only show its result.
+  set_tree_action_->setEnabled(!autotune);
+  set_double_action_->setEnabled(!autotune);
+  set_single_action_->setEnabled(!autotune);
+  UpdateTuning();
+}
+
+void MainWindow::SetCutoff() {
+  QMetaObject::invokeMethod(scene_->simulation_, "SetSoftening",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Softening,
+                                  Simulation::kCutoff));
+}
+
+void MainWindow::SetPlummer() {
+  QMetaObject::invokeMethod(scene_->simulation_, "SetSoftening",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Softening,
+                                  Simulation::kPlummer));
+}
+
+void MainWindow::SetSpline() {
+  QMetaObject::invokeMethod(scene_->simulation_, "SetSoftening",
+                            Qt::QueuedConnection,
+                            Q_ARG(Simulation::Softening,
+                                  Simulation::kSpline));
+}
+
+void MainWindow::ChangeSofteningLength() {
+  bool ok;
+  qreal length = QInputDialog::getDouble(
+      this, "Softening length", "Softening length:",
+      softening_length_, 0.01, 1000.0, 2, &ok);
+  if (ok) {
+    softening_length_ = length;
+    QMetaObject::invokeMethod(scene_->simulation_, "SetSofteningLength",
+                              Qt::QueuedConnection, Q_ARG(qreal, length));
+  }
+}
+
+void MainWindow::SetDeterministic() {
+  const bool deterministic = set_deterministic_action_->isChecked();
+  QMetaObject::invokeMethod(scene_->simulation_, "SetDeterministic",
+                            Qt::QueuedConnection, Q_ARG(bool, deterministic));
+}
+
+void MainWindow::SetTestParticle() {
+  scene_->SetTestParticle(set_test_particle_action_->isChecked());
+}
+
+void MainWindow::UpdateMemory() {
+  // Numbers come with last drawn Frame, so simulation is never waited for.
+  const Frame &frame = scene_->GetFrame();
+  QString label_text = "<font color='white'>Memory: ";
+  label_text += QString::number(frame.reserved_bytes / 1048576.0, 'f', 1);
+  label_text += " MB reserved, ";
+  label_text += QString::number(frame.memory_bytes / 1048576.0, 'f', 1);
+  label_text += " MB used (";
+  label_text += QString::number(frame.radii.size());
+  label_text += " bodies)";
+  // On machines with more sockets shows how force arrays are spread.
+  if (frame.node_bytes.size() > 1) {
+    label_text += ", nodes:";
+    foreach (qint64 bytes, frame.node_bytes)
+      label_text += " " + QString::number(bytes / 1048576.0, 'f', 1);
+    label_text += " MB";
+  }
+  label_text += "</font>";
+  memory_label_->setText(label_text);
+}
+
+void MainWindow::UpdateTuning() {
+  if (!set_autotune_action_->isChecked()) {
+    tuning_label_->setText("");
+    return;
+  }
+  // Choice comes with last drawn Frame, as tuning runs inside step.
+  const Frame &frame = scene_->GetFrame();
+  const bool tree = frame.tree;
+  const bool single = frame.single_precision;
+  set_tree_action_->setChecked(tree);
+  set_single_action_->setChecked(single);
+  set_double_action_->setChecked(!single);
+  QString label_text = "<font color='white'>Tuned: ";
+  label_text += tree ? "tree, " : "direct, ";
+  label_text += single ? "single, " : "double, ";
+  label_text += QString::number(frame.thread_count);
+  label_text += " threads</font>";
+  tuning_label_->setText(label_text);
 }
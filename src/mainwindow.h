@@ -37,6 +37,7 @@
 #include <QMenu>
 #include <QPushButton>
 #include <QShortcut>
+#include <QTimer>
 
 #include "scene.h"
 #include "view.h"
@@ -48,6 +49,13 @@ class MainWindow : public QMainWindow {
   Q_OBJECT
 
  public:
+  // Interval between updates of memory usage and tuning [ms].
+  static constexpr int kMemoryInterval = 1000;
+  // Initial positions of time slider. In adaptive mode it sets exponent of
+  // tolerance, 1e-8 at 40.
+  static constexpr int kDefaultTimeValue = 10;
+  static constexpr int kDefaultToleranceValue = 40;
+
   /**
     * @brief MainWindow constructor.
     * @param parent Parent of object.
@@ -96,37 +104,10 @@ class MainWindow : public QMainWindow {
   void LayoutInit();
 
   /**
-    * @brief  Finds random integer number in specified range.
-    * @param  low Minimum value.
-    * @param  high Maximum value.
-    * @retval Random integer number.
+    * @brief Switches time slider between setting time step and tolerance.
+    * @param adaptive Is adaptive method used?
     */
-  int RandInt(int low, int high) const;
-
-  /**
-    * @brief  Adds new planet to Scene.
-    * @param  mass Mass of new planet [10^24 kg].
-    * @param  density Density of new planet [kg/m^3].
-    * @param  semi_major_axis Semi-major axis of orbit of new planet [10^6 km].
-    * @param  eccentricity Eccentricity of orbit of new planet.
-    * @param  angle Initial angle of orbit of new planet [°].
-    * @retval New planet.
-    */
-  Body *AddPlanet(qreal mass, qreal density, qreal semi_major_axis,
-                  qreal eccentricity, qreal angle);
-
-  /**
-    * @brief  Adds new moon to Scene.
-    * @param  planet Satellite of.
-    * @param  mass Mass of new moon [10^24 kg].
-    * @param  density Density of new moon [kg/m^3].
-    * @param  semi_major_axis Semi-major axis of orbit of new moon [10^6 km].
-    * @param  eccentricity Eccentricity of orbit of new moon.
-    * @param  angle Initial angle of orbit of new moon [°].
-    */
-  void AddMoon(const Body *planet, qreal mass, qreal density,
-               qreal semi_major_axis, qreal eccentricity,
-               qreal angle);
+  void SetAdaptive(bool adaptive);
 
   View *view_;
   Scene *scene_;
@@ -139,6 +120,12 @@ class MainWindow : public QMainWindow {
   QLabel *density_label_;
   QLabel *radius_label_;
   QLabel *time_label_;
+  QLabel *memory_label_;
+  QLabel *tuning_label_;
+  // Instruction set of kernels, chosen at startup.
+  QLabel *kernels_label_;
+  // Timer for updating memory usage and tuning.
+  QTimer *memory_timer_;
   QGridLayout *main_layout_;
   QPushButton *create_button_;
   QPushButton *delete_button_;
@@ -153,12 +140,39 @@ class MainWindow : public QMainWindow {
   QAction *load_sol_action_;
   QAction *load_proto_action_;
   QAction *set_trails_action_;
+  QAction *set_trail_length_action_;
+  QAction *set_exposure_action_;
+  QAction *set_heatmap_action_;
+  QAction *set_heatmap_mass_action_;
+  QAction *set_snapshots_action_;
   QAction *set_aa_action_;
   QAction *set_euler_action_;
   QAction *set_rk4_action_;
+  QAction *set_wh_action_;
+  QAction *set_dopri_action_;
   QActionGroup *options_action_group_;
+  QAction *set_double_action_;
+  QAction *set_single_action_;
+  QActionGroup *precision_action_group_;
+  QAction *set_tree_action_;
+  QAction *set_autotune_action_;
+  QAction *set_cutoff_action_;
+  QAction *set_plummer_action_;
+  QAction *set_spline_action_;
+  QActionGroup *softening_action_group_;
+  QAction *set_softening_length_action_;
+  QAction *set_deterministic_action_;
+  QAction *set_test_particle_action_;
   // Current zoom of View.
   qreal current_scale_;
+  // Does time slider set tolerance of adaptive method?
+  bool adaptive_;
+  // Positions of time slider for time step and for tolerance.
+  int time_value_;
+  int tolerance_value_;
+  // Values last passed to Simulation, offered again in dialogs.
+  int trail_length_;
+  qreal softening_length_;
 
  private slots:
   /**
@@ -181,6 +195,41 @@ class MainWindow : public QMainWindow {
     */
   void SetTrails();
 
+  /**
+    * @brief Asks for new length of trails.
+    */
+  void ChangeTrailLength();
+
+  /**
+    * @brief Toggles long exposure.
+    */
+  void SetLongExposure();
+
+  /**
+    * @brief Toggles density heatmap when zoomed out.
+    */
+  void SetHeatmap();
+
+  /**
+    * @brief Toggles weighting of density heatmap by mass.
+    */
+  void SetHeatmapMass();
+
+  /**
+    * @brief Starts or stops publishing snapshots into shared memory.
+    */
+  void SetSnapshots();
+
+  /**
+    * @brief Unchecks snapshots option after they could not be started.
+    */
+  void ShowSnapshotsError();
+
+  /**
+    * @brief Passes current mapping of View to Scene.
+    */
+  void UpdateViewTransform();
+
   /**
     * @brief Toggles antialiasing.
     */
@@ -210,8 +259,9 @@ class MainWindow : public QMainWindow {
   void ChangeRadius();
 
   /**
-    * @brief Changes time step of simulation.
-    * @param value New time step value.
+    * @brief Changes time step of simulation, or tolerance of adaptive
+    *        method.
+    * @param value New position of time slider.
     */
   void ChangeTime(int value);
 
@@ -230,6 +280,80 @@ class MainWindow : public QMainWindow {
     * @brief Set Euler method mode.
     */
   void SetRK4();
+
+  /**
+    * @brief Set Wisdom-Holman method mode, which allows long time steps in
+    *        planetary systems.
+    */
+  void SetWisdomHolman();
+
+  /**
+    * @brief Set adaptive Dormand-Prince method mode, in which time slider
+    *        sets tolerance.
+    */
+  void SetDormandPrince();
+
+  /**
+    * @brief Sums gravitational forces in double precision.
+    */
+  void SetDoublePrecision();
+
+  /**
+    * @brief Sums gravitational forces in single precision.
+    */
+  void SetSinglePrecision();
+
+  /**
+    * @brief Toggles summing gravitational forces with Barnes-Hut tree.
+    */
+  void SetTree();
+
+  /**
+    * @brief Toggles automatic choice of solver, precision and number of
+    *        threads.
+    */
+  void SetAutoTune();
+
+  /**
+    * @brief Cuts gravity off at short distances, without softening.
+    */
+  void SetCutoff();
+
+  /**
+    * @brief Softens gravity with Plummer kernel.
+    */
+  void SetPlummer();
+
+  /**
+    * @brief Softens gravity with cubic spline kernel.
+    */
+  void SetSpline();
+
+  /**
+    * @brief Asks for new softening length.
+    */
+  void ChangeSofteningLength();
+
+  /**
+    * @brief Toggles reproducible merging of Bodies and hashing of state.
+    */
+  void SetDeterministic();
+
+  /**
+    * @brief Toggles creating test particles instead of regular Bodies.
+    */
+  void SetTestParticle();
+
+  /**
+    * @brief Shows memory used by Bodies and their trails.
+    */
+  void UpdateMemory();
+
+  /**
+    * @brief Shows configuration chosen by automatic tuning, also in options
+    *        menu.
+    */
+  void UpdateTuning();
 };
 
 #endif // MAINWINDOW_H
@@ -0,0 +1,60 @@
+/**
+  ******************************************************************************
+  * @file    mpi_exchange.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   MPI exchange functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "mpi_exchange.h"
+
+#include <mpi.h>
+
+void ExchangeRecords(const QVector<QVector<double> > &outgoing,
+                     QVector<double> *incoming,
+                     QVector<int> *incoming_counts) {
+  const int process_count = outgoing.size();
+  QVector<int> send_counts(process_count);
+  QVector<int> send_offsets(process_count);
+  QVector<double> send_buffer;
+  for (int r = 0; r < process_count; ++r) {
+    send_counts[r] = outgoing.at(r).size();
+    send_offsets[r] = send_buffer.size();
+    send_buffer += outgoing.at(r);
+  }
+  QVector<int> receive_counts(process_count);
+  MPI_Alltoall(send_counts.data(), 1, MPI_INT, receive_counts.data(), 1,
+               MPI_INT, MPI_COMM_WORLD);
+  QVector<int> receive_offsets(process_count);
+  int total = 0;
+  for (int r = 0; r < process_count; ++r) {
+    receive_offsets[r] = total;
+    total += receive_counts.at(r);
+  }
+  incoming->resize(total);
+  MPI_Alltoallv(send_buffer.data(), send_counts.data(), send_offsets.data(),
+                MPI_DOUBLE, incoming->data(), receive_counts.data(),
+                receive_offsets.data(), MPI_DOUBLE, MPI_COMM_WORLD);
+  if (incoming_counts != NULL)
+    *incoming_counts = receive_counts;
+}
@@ -0,0 +1,49 @@
+/**
+  ******************************************************************************
+  * @file    mpi_exchange.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of MPI exchange functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef MPI_EXCHANGE_H
+#define MPI_EXCHANGE_H
+
+#include <QVector>
+
+/**
+  * @brief Sends records made of doubles to every process and receives
+  *        records sent to this one. Has to be called by all processes of
+  *        MPI_COMM_WORLD.
+  * @param outgoing Records for each process, indexed by its rank.
+  * @param incoming Records received from all processes, in order of their
+  *        ranks.
+  * @param incoming_counts Number of doubles received from each process.
+  *        May be NULL.
+  */
+void ExchangeRecords(const QVector<QVector<double> > &outgoing,
+                     QVector<double> *incoming,
+                     QVector<int> *incoming_counts = NULL);
+
+#endif // MPI_EXCHANGE_H
@@ -0,0 +1,237 @@
+/**
+  ******************************************************************************
+  * @file    neighbor_list.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   NeighborList class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "neighbor_list.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "cpu_features.h"
+
+/**
+  * @brief  Counts Bodies which moved and grew by more than their skins.
+  *         Every Body is checked, so the loop has no exit and is
+  *         vectorized.
+  * @param  count Number of Bodies.
+  * @param  positions Positions of Bodies.
+  * @param  old_positions Positions of Bodies at last rebuild.
+  * @param  radii Radii of Bodies.
+  * @param  old_radii Radii of Bodies at last rebuild.
+  * @param  skins Skins of Bodies.
+  * @retval Number of Bodies which used up their skins.
+  */
+static ALWAYS_INLINE int CountEscaped(int count, const QPointF *positions,
+                                      const QPointF *old_positions,
+                                      const qreal *radii,
+                                      const qreal *old_radii,
+                                      const qreal *skins) {
+  int escaped = 0;
+  for (int i = 0; i < count; ++i) {
+    const qreal delta_x = positions[i].x() - old_positions[i].x();
+    const qreal delta_y = positions[i].y() - old_positions[i].y();
+    const qreal moved = sqrt(delta_x * delta_x + delta_y * delta_y);
+    escaped += moved + radii[i] - old_radii[i] > skins[i] ? 1 : 0;
+  }
+  return escaped;
+}
+
+/**
+  * @brief Variants of CountEscaped, each compiled for one instruction set.
+  */
+static int CountEscapedBaseline(int count, const QPointF *positions,
+                                const QPointF *old_positions,
+                                const qreal *radii, const qreal *old_radii,
+                                const qreal *skins) {
+  return CountEscaped(count, positions, old_positions, radii, old_radii,
+                      skins);
+}
+
+#ifdef HAVE_ISA_DISPATCH
+static TARGET_AVX2 int CountEscapedAvx2(int count, const QPointF *positions,
+                                        const QPointF *old_positions,
+                                        const qreal *radii,
+                                        const qreal *old_radii,
+                                        const qreal *skins) {
+  return CountEscaped(count, positions, old_positions, radii, old_radii,
+                      skins);
+}
+
+static TARGET_AVX512 int CountEscapedAvx512(int count,
+                                            const QPointF *positions,
+                                            const QPointF *old_positions,
+                                            const qreal *radii,
+                                            const qreal *old_radii,
+                                            const qreal *skins) {
+  return CountEscaped(count, positions, old_positions, radii, old_radii,
+                      skins);
+}
+#endif
+
+NeighborList::NeighborList()
+    : count_escaped_(&CountEscapedBaseline),
+      skin_steps_(kDefaultSkinSteps),
+      skin_change_(2.0),
+      work_(0),
+      lifetime_(0),
+      last_cost_(-1.0) {
+#ifdef HAVE_ISA_DISPATCH
+  if (GetInstructionSet() == kAvx512)
+    count_escaped_ = &CountEscapedAvx512;
+  else if (GetInstructionSet() == kAvx2)
+    count_escaped_ = &CountEscapedAvx2;
+#endif
+}
+
+void NeighborList::Update(qreal time_step, const QVector<quint32> &ids,
+                          const QVector<QPointF> &positions,
+                          const QVector<QPointF> &velocities,
+                          const QVector<qreal> &radii) {
+  if (!Remap(ids) || !IsValid(positions, radii)) {
+    TuneSkin();
+    Build(time_step, ids, positions, velocities, radii);
+  }
+  // Every listed pair is checked by caller.
+  work_ += pairs_.size();
+  ++lifetime_;
+}
+
+const QVector<std::pair<int, int> > &NeighborList::GetPairs() const {
+  return pairs_;
+}
+
+bool NeighborList::Remap(const QVector<quint32> &ids) {
+  if (ids == ids_)
+    return true;
+  const int count = ids.size();
+  old_index_.clear();
+  for (int i = 0; i < ids_.size(); ++i)
+    old_index_.insert(ids_.at(i), i);
+  new_index_.fill(-1, ids_.size());
+  for (int i = 0; i < count; ++i) {
+    const int old = old_index_.value(ids.at(i), -1);
+    // Body which was not there at last rebuild can overlap any other.
+    if (old < 0)
+      return false;
+    new_index_[old] = i;
+  }
+  // Removed Bodies drop out with their pairs.
+  int kept = 0;
+  for (int p = 0; p < pairs_.size(); ++p) {
+    const int i = new_index_.at(pairs_.at(p).first);
+    const int j = new_index_.at(pairs_.at(p).second);
+    if (i >= 0 && j >= 0)
+      pairs_[kept++] = std::make_pair(std::min(i, j), std::max(i, j));
+  }
+  pairs_.resize(kept);
+  old_positions_.swap(positions_);
+  old_radii_.swap(radii_);
+  old_skins_.swap(skins_);
+  positions_.resize(count);
+  radii_.resize(count);
+  skins_.resize(count);
+  for (int old = 0; old < new_index_.size(); ++old) {
+    const int i = new_index_.at(old);
+    if (i >= 0) {
+      positions_[i] = old_positions_.at(old);
+      radii_[i] = old_radii_.at(old);
+      skins_[i] = old_skins_.at(old);
+    }
+  }
+  ids_ = ids;
+  return true;
+}
+
+bool NeighborList::IsValid(const QVector<QPointF> &positions,
+                           const QVector<qreal> &radii) const {
+  // Pair can overlap only if its Bodies used up both skins.
+  return count_escaped_(positions.size(), positions.constData(),
+                        positions_.constData(), radii.constData(),
+                        radii_.constData(), skins_.constData()) == 0;
+}
+
+void NeighborList::Build(qreal time_step, const QVector<quint32> &ids,
+                         const QVector<QPointF> &positions,
+                         const QVector<QPointF> &velocities,
+                         const QVector<qreal> &radii) {
+  const int count = positions.size();
+  skins_.resize(count);
+  reaches_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    const QPointF &velocity = velocities.at(i);
+    const qreal speed = sqrt(velocity.x() * velocity.x() +
+                             velocity.y() * velocity.y());
+    skins_[i] = std::max(skin_steps_ * speed * time_step,
+                         kMinSkinRadii * radii.at(i));
+    reaches_[i] = radii.at(i) + skins_.at(i);
+  }
+
+  // Bodies are sorted by left edge of reach, so only pairs which overlap
+  // along x axis are checked.
+  sweep_order_.resize(count);
+  for (int i = 0; i < count; ++i)
+    sweep_order_[i] = i;
+  std::sort(sweep_order_.begin(), sweep_order_.end(),
+            [&positions, this](int a, int b) {
+    return positions.at(a).x() - reaches_.at(a) <
+           positions.at(b).x() - reaches_.at(b);
+  });
+  // Sorting costs about as much as one check per Body.
+  work_ += count;
+  pairs_.clear();
+  for (int a = 0; a < count; ++a) {
+    const int i = sweep_order_.at(a);
+    const qreal right = positions.at(i).x() + reaches_.at(i);
+    for (int b = a + 1; b < count; ++b) {
+      const int j = sweep_order_.at(b);
+      if (positions.at(j).x() - reaches_.at(j) > right)
+        break;
+      ++work_;
+      const QPointF delta = positions.at(j) - positions.at(i);
+      const qreal reach = reaches_.at(i) + reaches_.at(j);
+      if (delta.x() * delta.x() + delta.y() * delta.y() <= reach * reach)
+        pairs_.append(std::make_pair(std::min(i, j), std::max(i, j)));
+    }
+  }
+  ids_ = ids;
+  positions_ = positions;
+  radii_ = radii;
+}
+
+void NeighborList::TuneSkin() {
+  if (lifetime_ > 0) {
+    const qreal cost = static_cast<qreal>(work_) / lifetime_;
+    if (last_cost_ >= 0.0 && cost > last_cost_)
+      skin_change_ = 1.0 / skin_change_;
+    last_cost_ = cost;
+    skin_steps_ = qBound(static_cast<qreal>(kMinSkinSteps),
+                         skin_steps_ * skin_change_,
+                         static_cast<qreal>(kMaxSkinSteps));
+  }
+  work_ = 0;
+  lifetime_ = 0;
+}
@@ -0,0 +1,159 @@
+/**
+  ******************************************************************************
+  * @file    neighbor_list.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of NeighborList class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef NEIGHBOR_LIST_H
+#define NEIGHBOR_LIST_H
+
+#include <QHash>
+#include <QPointF>
+#include <QVector>
+#include <utility>
+
+/**
+  * @brief Cached list of pairs of Bodies which can collide soon (Verlet
+  *        list). Pairs are found with radii enlarged by skin of each Body,
+  *        so list stays complete until some Body moves and grows by more
+  *        than its skin. Skin follows speed of Body, so slow Bodies do not
+  *        list fast ones far away. Between rebuilds only listed pairs are
+  *        checked. Longer skin means fewer rebuilds, but more listed pairs,
+  *        so number of steps covered by skin is tuned to the least work
+  *        per step.
+  */
+class NeighborList {
+ public:
+  // Skin of Body is that many times longer than distance it travels in
+  // one step. Number of steps starts at default and is doubled or halved
+  // between limits at every rebuild.
+  static constexpr qreal kDefaultSkinSteps = 1.0;
+  static constexpr qreal kMinSkinSteps = 0.0625;
+  static constexpr qreal kMaxSkinSteps = 32.0;
+  // Skin is never shorter than that fraction of radius of Body, so Bodies
+  // at rest, like central star of preset, do not force rebuild as soon as
+  // they start moving.
+  static constexpr qreal kMinSkinRadii = 0.1;
+
+  /**
+    * @brief NeighborList constructor.
+    */
+  NeighborList();
+
+  /**
+    * @brief Follows Bodies to their new indices and rebuilds list if some
+    *        Body is new or moved too far since last rebuild.
+    * @param time_step Time step.
+    * @param ids Ids of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    * @param radii Radii of Bodies.
+    */
+  void Update(qreal time_step, const QVector<quint32> &ids,
+              const QVector<QPointF> &positions,
+              const QVector<QPointF> &velocities,
+              const QVector<qreal> &radii);
+
+  /**
+    * @brief  Pairs accessor.
+    * @retval Indices of pairs of Bodies which can overlap, lower first.
+    */
+  const QVector<std::pair<int, int> > &GetPairs() const;
+
+ private:
+  /**
+    * @brief  Moves pairs and reference state to new indices of Bodies.
+    * @param  ids Ids of Bodies.
+    * @retval Is every Body already known?
+    */
+  bool Remap(const QVector<quint32> &ids);
+
+  /**
+    * @brief  Checks whether listed pairs still contain every overlap.
+    * @param  positions Positions of Bodies.
+    * @param  radii Radii of Bodies.
+    * @retval Has no Body moved and grown by more than its skin?
+    */
+  bool IsValid(const QVector<QPointF> &positions,
+               const QVector<qreal> &radii) const;
+
+  /**
+    * @brief Finds all pairs of Bodies closer than sum of their radii and
+    *        skins, sweeping Bodies sorted by left edge of reach.
+    * @param time_step Time step.
+    * @param ids Ids of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    * @param radii Radii of Bodies.
+    */
+  void Build(qreal time_step, const QVector<quint32> &ids,
+             const QVector<QPointF> &positions,
+             const QVector<QPointF> &velocities,
+             const QVector<qreal> &radii);
+
+  /**
+    * @brief Changes number of steps covered by skin in the direction which
+    *        lowered work per step last time.
+    */
+  void TuneSkin();
+
+  // Counts Bodies which moved and grew by more than their skins, from
+  // number of Bodies, their positions, old positions, radii, old radii and
+  // skins. Compiled for instruction set of processor.
+  typedef int (*EscapeCounter)(int, const QPointF*, const QPointF*,
+                               const qreal*, const qreal*, const qreal*);
+
+  EscapeCounter count_escaped_;
+  QVector<std::pair<int, int> > pairs_;
+  // Number of steps of motion covered by skin.
+  qreal skin_steps_;
+  // Factor by which skin_steps_ is changed at next rebuild.
+  qreal skin_change_;
+  // Pairs checked since last rebuild, including rebuild itself, and steps
+  // since it.
+  qint64 work_;
+  int lifetime_;
+  // Work per step of previous list, negative before first one.
+  qreal last_cost_;
+  // Ids, positions, radii and skins of Bodies at last rebuild, indexed like
+  // current Bodies.
+  QVector<quint32> ids_;
+  QVector<QPointF> positions_;
+  QVector<qreal> radii_;
+  QVector<qreal> skins_;
+  // Index of every known Body, used when Bodies change.
+  QHash<quint32, int> old_index_;
+  // New index of each old one, -1 for removed Bodies.
+  QVector<int> new_index_;
+  QVector<QPointF> old_positions_;
+  QVector<qreal> old_radii_;
+  QVector<qreal> old_skins_;
+  // Reach of each Body, radius and skin.
+  QVector<qreal> reaches_;
+  // Indices of Bodies sorted by left edge of reach.
+  QVector<int> sweep_order_;
+};
+
+#endif // NEIGHBOR_LIST_H
@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file    numa_placement.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   NUMA placement functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "numa_placement.h"
+
+#include <QDir>
+#include <QStringList>
+#include <algorithm>
+#ifdef Q_OS_LINUX
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+int GetNumaNodeCount() {
+#ifdef Q_OS_LINUX
+  const QDir nodes("/sys/devices/system/node");
+  return std::max(nodes.entryList(QStringList("node*"), QDir::Dirs).size(),
+                  1);
+#else
+  return 1;
+#endif
+}
+
+void CountNodeBytes(const void *data, qint64 bytes,
+                    QVector<qint64> *node_bytes) {
+  if (bytes <= 0)
+    return;
+  if (node_bytes->isEmpty())
+    node_bytes->resize(1);
+#ifdef Q_OS_LINUX
+  // Number of pages asked about in one system call.
+  const int kBatchSize = 1024;
+  const quintptr page_size = sysconf(_SC_PAGESIZE);
+  const quintptr begin = reinterpret_cast<quintptr>(data);
+  const quintptr end = begin + bytes;
+  void *pages[kBatchSize];
+  int nodes[kBatchSize];
+  for (quintptr batch = begin & ~(page_size - 1); batch < end;
+       batch += kBatchSize * page_size) {
+    int count = 0;
+    for (quintptr page = batch; page < end && count < kBatchSize;
+         page += page_size)
+      pages[count++] = reinterpret_cast<void*>(page);
+    // Without target nodes move_pages only tells where pages are. Kernel
+    // without NUMA does not have it.
+    if (syscall(SYS_move_pages, 0, count, pages, NULL, nodes, 0) != 0) {
+      (*node_bytes)[0] += end - std::max(batch, begin);
+      return;
+    }
+    for (int i = 0; i < count; ++i) {
+      // Negative status is error code of page which is not in memory.
+      if (nodes[i] < 0)
+        continue;
+      const quintptr page = reinterpret_cast<quintptr>(pages[i]);
+      const qint64 page_bytes = std::min(page + page_size, end) -
+                                std::max(page, begin);
+      if (nodes[i] >= node_bytes->size())
+        node_bytes->resize(nodes[i] + 1);
+      (*node_bytes)[nodes[i]] += page_bytes;
+    }
+  }
+#else
+  Q_UNUSED(data);
+  (*node_bytes)[0] += bytes;
+#endif
+}
@@ -0,0 +1,54 @@
+/**
+  ******************************************************************************
+  * @file    numa_placement.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of NUMA placement functions.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef NUMA_PLACEMENT_H
+#define NUMA_PLACEMENT_H
+
+#include <QVector>
+#include <QtGlobal>
+
+/**
+  * @brief  Finds number of NUMA nodes, which are processor sockets with
+  *         their own memory.
+  * @retval Number of nodes, 1 without NUMA.
+  */
+int GetNumaNodeCount();
+
+/**
+  * @brief Adds bytes of memory range to nodes where its pages are. Pages
+  *        are placed on node of thread which first touches them, and ones
+  *        never touched are not counted. Without NUMA all bytes are on
+  *        node 0.
+  * @param data Beginning of range.
+  * @param bytes Size of range [B].
+  * @param node_bytes Bytes on each node, extended when needed.
+  */
+void CountNodeBytes(const void *data, qint64 bytes,
+                    QVector<qint64> *node_bytes);
+
+#endif // NUMA_PLACEMENT_H
@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file    object_pool.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   ObjectPool class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#include "object_pool.h"
+
+#include <algorithm>
+
+ObjectPool::ObjectPool(size_t object_size)
+    : free_list_(NULL),
+      used_count_(0) {
+  // Freed objects have to hold link and keep alignment of any type.
+  const size_t alignment = alignof(std::max_align_t);
+  object_size = std::max(object_size, sizeof(FreeObject));
+  object_size_ = (object_size + alignment - 1) / alignment * alignment;
+  chunk_objects_ = static_cast<int>(
+      std::max<size_t>(kChunkBytes / object_size_, 1));
+}
+
+ObjectPool::~ObjectPool() {
+  for (char *chunk : chunks_)
+    delete[] chunk;
+}
+
+void *ObjectPool::Allocate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (free_list_ == NULL) {
+    char *chunk = new char[object_size_ * chunk_objects_];
+    chunks_.push_back(chunk);
+    // Objects are linked from the end, so they are taken in order of
+    // addresses.
+    for (int i = chunk_objects_ - 1; i >= 0; --i) {
+      FreeObject *object =
+          reinterpret_cast<FreeObject*>(chunk + i * object_size_);
+      object->next = free_list_;
+      free_list_ = object;
+    }
+  }
+  FreeObject *object = free_list_;
+  free_list_ = object->next;
+  ++used_count_;
+  return object;
+}
+
+void ObjectPool::Free(void *object) {
+  if (object == NULL)
+    return;
+  std::lock_guard<std::mutex> lock(mutex_);
+  FreeObject *free_object = static_cast<FreeObject*>(object);
+  free_object->next = free_list_;
+  free_list_ = free_object;
+  --used_count_;
+}
+
+int ObjectPool::GetUsedCount() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return used_count_;
+}
+
+size_t ObjectPool::GetObjectSize() const {
+  return object_size_;
+}
+
+qint64 ObjectPool::GetReservedBytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<qint64>(chunks_.size()) * object_size_ * chunk_objects_;
+}
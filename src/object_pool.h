@@ -0,0 +1,106 @@
+/**
+  ******************************************************************************
+  * @file    object_pool.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of ObjectPool class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <QtGlobal>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+/**
+  * @brief Allocator of objects of one size. Memory is reserved in large
+  *        chunks and freed objects are recycled, so creating and destroying
+  *        many objects does not fragment heap and memory use stays flat.
+  *        Chunks are released only with pool. Thread safe.
+  */
+class ObjectPool {
+ public:
+  // Size of one chunk [B]. Chunk holds at least one object, so objects
+  // bigger than that get chunk of their own.
+  static constexpr size_t kChunkBytes = 64 * 1024;
+
+  /**
+    * @brief ObjectPool constructor.
+    * @param object_size Size of allocated objects [B].
+    */
+  explicit ObjectPool(size_t object_size);
+
+  /**
+    * @brief ObjectPool destructor. Releases all chunks.
+    */
+  ~ObjectPool();
+
+  /**
+    * @brief  Takes memory for one object, reserving new chunk if needed.
+    * @retval Uninitialized memory.
+    */
+  void *Allocate();
+
+  /**
+    * @brief Returns memory of object to pool.
+    * @param object Memory taken by Allocate().
+    */
+  void Free(void *object);
+
+  /**
+    * @brief  Used count accessor.
+    * @retval Number of objects allocated and not freed.
+    */
+  int GetUsedCount();
+
+  /**
+    * @brief  Object size accessor.
+    * @retval Size of memory taken by one object, including padding [B].
+    */
+  size_t GetObjectSize() const;
+
+  /**
+    * @brief  Reserved size accessor.
+    * @retval Size of all chunks [B].
+    */
+  qint64 GetReservedBytes();
+
+ private:
+  // Freed object, which stores pointer to next one.
+  struct FreeObject {
+    FreeObject *next;
+  };
+
+  size_t object_size_;
+  // Number of objects in one chunk.
+  int chunk_objects_;
+  std::mutex mutex_;
+  std::vector<char*> chunks_;
+  // Singly linked list of freed objects.
+  FreeObject *free_list_;
+  int used_count_;
+};
+
+#endif // OBJECT_POOL_H
@@ -0,0 +1,208 @@
+/**
+  ******************************************************************************
+  * @file    presets.cc
+  * @author  Karol Leszczyński
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Presets of Bodies.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "presets.h"
+
+#include <QtMath>
+
+#include "simulation.h"
+
+/**
+  * @brief  Finds random integer number in specified range.
+  * @param  low Minimum value.
+  * @param  high Maximum value.
+  * @retval Random integer number.
+  */
+static int RandInt(int low, int high) {
+  return qrand() % ((high + 1) - low) + low;
+}
+
+/**
+  * @brief  Changes value by random fraction of it.
+  * @param  value Original value.
+  * @param  perturbation Largest relative change.
+  * @retval Changed value.
+  */
+static qreal Perturbed(qreal value, qreal perturbation) {
+  return value * (1.0 + perturbation * RandInt(-1000, 1000) * 0.001);
+}
+
+/**
+  * @brief  Creates new planet orbiting Sun.
+  * @param  bodies List to which new planet is appended.
+  * @param  perturbation Largest relative change of semi-major axis and
+  *         eccentricity of orbit.
+  * @param  mass Mass of new planet [10^24 kg].
+  * @param  density Density of new planet [kg/m^3].
+  * @param  semi_major_axis Semi-major axis of orbit of new planet [10^6 km].
+  * @param  eccentricity Eccentricity of orbit of new planet.
+  * @param  angle Initial angle of orbit of new planet [°].
+  * @retval New planet.
+  */
+static Body *AddPlanet(QList<Body*> *bodies, qreal perturbation, qreal mass,
+                       qreal density, qreal semi_major_axis,
+                       qreal eccentricity, qreal angle) {
+  if (perturbation > 0.0) {
+    semi_major_axis = Perturbed(semi_major_axis, perturbation);
+    eccentricity = Perturbed(eccentricity, perturbation);
+  }
+  // Calculations of proper velocity and position of planet which will create
+  // desired orbit around Sun.
+  qreal velocity = Simulation::kGravConstant * 1989100 * (1 + eccentricity);
+  velocity /= semi_major_axis * 100 * (1 - eccentricity);
+  velocity = sqrt(velocity);
+  qreal position = semi_major_axis * 100 * (1 - eccentricity);
+  qreal angle_rad = angle * M_PI / 180;
+  Body *body = new Body(mass, 10 * cbrt(mass / (density * 4.189)),
+                        -velocity * sin(angle_rad), velocity * cos(angle_rad),
+                        position * cos(angle_rad), position * sin(angle_rad));
+  bodies->append(body);
+  return body;
+}
+
+/**
+  * @brief Creates new moon orbiting planet.
+  * @param bodies List to which new moon is appended.
+  * @param planet Satellite of.
+  * @param mass Mass of new moon [10^24 kg].
+  * @param density Density of new moon [kg/m^3].
+  * @param semi_major_axis Semi-major axis of orbit of new moon [10^6 km].
+  * @param eccentricity Eccentricity of orbit of new moon.
+  * @param angle Initial angle of orbit of new moon [°].
+  */
+static void AddMoon(QList<Body*> *bodies, const Body *planet, qreal mass,
+                    qreal density, qreal semi_major_axis, qreal eccentricity,
+                    qreal angle) {
+  // Calculations of proper velocity and position of moon which will create
+  // desired orbit around planet.
+  qreal velocity = Simulation::kGravConstant;
+  velocity *= planet->GetMass() * (1 + eccentricity);
+  velocity /= semi_major_axis * 100 * (1  -eccentricity);
+  velocity = sqrt(velocity);
+  qreal position = semi_major_axis * 100 * (1 - eccentricity);
+  qreal angle_rad = angle * M_PI / 180;
+  Body *body = new Body(mass, 10 * cbrt(mass / (density * 4.189)),
+                        -velocity * sin(angle_rad) + planet->GetVelocity().x(),
+                        velocity * cos(angle_rad) + planet->GetVelocity().y(),
+                        position * cos(angle_rad) + planet->GetPosition().x(),
+                        position * sin(angle_rad) + planet->GetPosition().y());
+  bodies->append(body);
+}
+
+QList<Body*> CreateSolarSystem(qreal perturbation) {
+  QList<Body*> bodies;
+
+  // Add Sun.
+  Body *body = new Body(1989100.0, 10 * cbrt(1989100 / (1409 * 4.189)),
+                        0.0, 0.0, 0.0, 0.0);
+  bodies.append(body);
+
+  // Add planets and moons.
+  // Mercury.
+  body = AddPlanet(&bodies, perturbation,
+                   0.3301, 5427, 57.909227, 0.20563593, 48.331);
+  // Venus.
+  body = AddPlanet(&bodies, perturbation,
+                   4.8673, 5243, 108.20948, 0.00677672, 76.678);
+  // Earth.
+  body = AddPlanet(&bodies, perturbation,
+                   5.9722, 5513, 149.59826, 0.01671123, 348.73936);
+  AddMoon(&bodies, body, 0.073477, 3346, 0.384399, 0.0549, 125.08);  // Moon
+  // Mars.
+  body = AddPlanet(&bodies, perturbation,
+                   0.64169, 3934, 227.94382, 0.0933941, 49.562);
+  // Jupiter.
+  body = AddPlanet(&bodies, perturbation,
+                   1898.1, 1326, 778.34082, 0.04838624, 100.492);
+  AddMoon(&bodies, body, 0.0894, 3528, 0.4216, 0.0041, 0);      // Io
+  AddMoon(&bodies, body, 0.048, 3010, 0.6709, 0.009, 0);        // Europa
+  AddMoon(&bodies, body, 0.14819, 1936, 1.0704, 0.0013, 0);     // Ganymede
+  AddMoon(&bodies, body, 0.10758, 1830, 1.8827, 0.0074, 0);     // Callisto
+  // Saturn.
+  body = AddPlanet(&bodies, perturbation,
+                   568.32, 687, 1426.6664, 0.05386179, 113.643);
+  AddMoon(&bodies, body, 0.0000375, 1150, 0.18552, 0.0202, 0);  // Mimas
+  AddMoon(&bodies, body, 0.000108, 1610, 0.237948, 0.0047, 0);  // Enceladus
+  AddMoon(&bodies, body, 0.0006174, 980, 0.294619, 0.02, 0);    // Tethys
+  AddMoon(&bodies, body, 0.001095, 1480, 0.377396, 0.002, 0);   // Dione
+  AddMoon(&bodies, body, 0.002306, 1230, 0.527108, 0.001, 0);   // Rhea
+  AddMoon(&bodies, body, 0.13452, 1880, 1.22187, 0.0288, 0);    // Titan
+  AddMoon(&bodies, body, 0.0018053, 1080, 3.56082, 0.0286, 0);  // Iapetus
+  // Uranus.
+  body = AddPlanet(&bodies, perturbation,
+                   86.81, 1270, 2870.6582, 0.04725744, 73.99);
+  AddMoon(&bodies, body, 0.0000659, 1200, 0.12939, 0.0013, 0);  // Miranda
+  AddMoon(&bodies, body, 0.00135, 1670, 0.1909, 0.0012, 0);     // Ariel
+  AddMoon(&bodies, body, 0.0012, 1400, 0.2662, 0.005, 0);       // Umbriel
+  AddMoon(&bodies, body, 0.0035, 1720, 0.4363, 0.0011, 0);      // Titania
+  AddMoon(&bodies, body, 0.003014, 1630, 0.583519, 0.0014, 0);  // Oberon
+  // Neptune.
+  body = AddPlanet(&bodies, perturbation,
+                   102.41, 1638, 4498.3964, 0.00859048, 131.794);
+  AddMoon(&bodies, body, 0.0214, 2061, 0.354759, 0.00002, 0);   // Triton
+  return bodies;
+}
+
+QList<Body*> CreateProtodisk(int count, bool test_particles) {
+  QList<Body*> bodies;
+  qreal mass;
+  qreal radius;
+  qreal density;
+  Body *body;
+
+  // Add protostar.
+  mass = 1000000;
+  density = 6000;
+  radius = 100.0 * cbrt(mass / (density * 4.189));
+  body = new Body(mass, radius, 0.0, 0.0, 0.0, 0.0);
+  bodies.append(body);
+
+  // Add protodisk objects.
+  mass = 1;
+  density = 500;
+  radius = 100.0 * cbrt(mass / (density * 4.189));
+  for (int i = 0; i < count; ++i) {
+    qreal min_disk_radius_squared = 250000.0;
+    qreal max_disk_radius_squared = 2250000.0;
+    qreal disk_radius = RandInt(0, 1000) * 0.001;
+    disk_radius *= max_disk_radius_squared - min_disk_radius_squared;
+    disk_radius += min_disk_radius_squared;
+    disk_radius = sqrt(disk_radius);
+    qreal disk_angle = RandInt(0, 3600) * 0.1 * M_PI / 180.0;
+    qreal body_vel_x = -sqrt(6673850000.0 / disk_radius) * sin(disk_angle);
+    qreal body_vel_y = sqrt(6673850000.0 / disk_radius) * cos(disk_angle);
+    qreal body_pos_x = disk_radius * cos(disk_angle);
+    qreal body_pos_y = disk_radius * sin(disk_angle);
+    body = new Body(mass, radius,
+                    body_vel_x, body_vel_y, body_pos_x, body_pos_y);
+    body->SetTestParticle(test_particles);
+    bodies.append(body);
+  }
+  return bodies;
+}
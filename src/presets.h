@@ -0,0 +1,61 @@
+/**
+  ******************************************************************************
+  * @file    presets.h
+  * @author  Karol Leszczyński
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of presets of Bodies.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef PRESETS_H
+#define PRESETS_H
+
+#include <QList>
+
+#include "body.h"
+
+// Zoom of View suitable for each preset (logarithmic, as zoom slider).
+const int kSolarSystemZoom = -100;
+const int kProtodiskZoom = -70;
+// Default number of objects in protoplanetary disk.
+const int kProtodiskBodies = 1000;
+
+/**
+  * @brief  Creates Sun with planets of Solar System and their largest moons.
+  * @param  perturbation Largest relative random change of semi-major axis
+  *         and eccentricity of orbits of planets.
+  * @retval New Bodies, owned by caller.
+  */
+QList<Body*> CreateSolarSystem(qreal perturbation = 0.0);
+
+/**
+  * @brief  Creates protostar surrounded by disk of small objects.
+  * @param  count Number of objects in disk.
+  * @param  test_particles Should objects in disk be test particles, which
+  *         are pulled only by protostar?
+  * @retval New Bodies, owned by caller.
+  */
+QList<Body*> CreateProtodisk(int count = kProtodiskBodies,
+                             bool test_particles = false);
+
+#endif // PRESETS_H
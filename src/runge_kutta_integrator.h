@@ -0,0 +1,112 @@
+/**
+  ******************************************************************************
+  * @file    runge_kutta_integrator.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of RungeKuttaIntegrator class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef RUNGE_KUTTA_INTEGRATOR_H
+#define RUNGE_KUTTA_INTEGRATOR_H
+
+#include <QPointF>
+#include <QVector>
+
+/**
+  * @brief Integration policy of classic fourth order Runge-Kutta method.
+  *        All stages share one loop, driven by coefficients of the method.
+  */
+template <class Solver>
+class RungeKuttaIntegrator {
+ public:
+  static constexpr int kStages = 4;
+
+  /**
+    * @brief Tolerance mutator. Time step is fixed, so tolerance is not used.
+    * @param tolerance Largest error of one step.
+    */
+  void SetTolerance(qreal tolerance) {
+    Q_UNUSED(tolerance);
+  }
+
+  /**
+    * @brief Advances Bodies by one time step.
+    * @param time_step Time step.
+    * @param solver Force policy.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void Advance(qreal time_step, Solver *solver, const QVector<qreal> &masses,
+               QVector<QPointF> *positions, QVector<QPointF> *velocities) {
+    // Fractions of time step at which stages are evaluated and weights of
+    // their derivatives.
+    static const qreal kNodes[kStages] = {0.0, 0.5, 0.5, 1.0};
+    static const qreal kWeights[kStages] = {1.0 / 6.0, 2.0 / 6.0,
+                                            2.0 / 6.0, 1.0 / 6.0};
+    const int count = positions->size();
+    stage_positions_ = *positions;
+    stage_velocities_ = *velocities;
+    delta_positions_.fill(QPointF(0.0, 0.0), count);
+    delta_velocities_.fill(QPointF(0.0, 0.0), count);
+
+    const QPointF *position = positions->constData();
+    const QPointF *velocity = velocities->constData();
+    for (int stage = 0; stage < kStages; ++stage) {
+      solver->Accelerate(stage_positions_, masses, &accelerations_);
+      const QPointF *acceleration = accelerations_.constData();
+      QPointF *stage_position = stage_positions_.data();
+      QPointF *stage_velocity = stage_velocities_.data();
+      QPointF *delta_position = delta_positions_.data();
+      QPointF *delta_velocity = delta_velocities_.data();
+      const qreal weight = kWeights[stage];
+      // After last stage next one is not needed, but computing it is cheaper
+      // than branching.
+      const qreal next = kNodes[(stage + 1) % kStages] * time_step;
+      for (int i = 0; i < count; ++i) {
+        delta_position[i] += stage_velocity[i] * weight;
+        delta_velocity[i] += acceleration[i] * weight;
+        stage_position[i] = position[i] + stage_velocity[i] * next;
+        stage_velocity[i] = velocity[i] + acceleration[i] * next;
+      }
+    }
+
+    QPointF *new_position = positions->data();
+    QPointF *new_velocity = velocities->data();
+    for (int i = 0; i < count; ++i) {
+      new_position[i] += delta_positions_.at(i) * time_step;
+      new_velocity[i] += delta_velocities_.at(i) * time_step;
+    }
+  }
+
+ private:
+  // Positions and velocities at which next stage is evaluated.
+  QVector<QPointF> stage_positions_;
+  QVector<QPointF> stage_velocities_;
+  // Weighted sums of derivatives of all stages.
+  QVector<QPointF> delta_positions_;
+  QVector<QPointF> delta_velocities_;
+  QVector<QPointF> accelerations_;
+};
+
+#endif // RUNGE_KUTTA_INTEGRATOR_H
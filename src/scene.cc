@@ -34,17 +34,20 @@
 Scene::Scene(QObject *parent, qreal view_scale)
     : QGraphicsScene(parent),
       trails_(false),
-      runge_kutta_(false),
+      long_exposure_(false),
       view_scale_(view_scale),
+      heatmap_(false),
       new_mass_(1.0),
       new_density_(1.0),
       new_radius_(1.0),
+      new_test_particle_(false),
       tool_(kNone),
-      time_step_(1.0) {
+      auto_heatmap_(true) {
   setBackgroundBrush(Qt::black);
+  // There are only few items and they cull Bodies on their own.
   setItemIndexMethod(QGraphicsScene::NoIndex);
-  // Temporary object used to stretch Scene.
-  addItem(new QGraphicsEllipseItem(-1000000, -1000000, 2000000, 2000000));
+  setSceneRect(-kMinSceneSize / 2, -kMinSceneSize / 2,
+               kMinSceneSize, kMinSceneSize);
 
   creation_line_ = new QGraphicsLineItem();
   addItem(creation_line_);
@@ -53,19 +56,38 @@ Scene::Scene(QObject *parent, qreal view_scale)
   creation_line_->setVisible(false);
   creation_line_->setZValue(2);
 
-  advancing_timer_ = new QTimer(this);
-  connect(advancing_timer_, SIGNAL(timeout()), this, SLOT(Advance()));
-  advancing_timer_->start(10);
+  bodies_item_ = new BodiesItem();
+  addItem(bodies_item_);
+  trails_item_ = new TrailsItem();
+  addItem(trails_item_);
+  exposure_item_ = new ExposureItem();
+  addItem(exposure_item_);
+  exposure_item_->setVisible(false);
+  heatmap_item_ = new HeatmapItem();
+  addItem(heatmap_item_);
+  heatmap_item_->setVisible(false);
+
+  frame_timer_ = new QTimer(this);
+  frame_timer_->setSingleShot(true);
+  frame_timer_->setInterval(kFrameInterval);
+  connect(frame_timer_, SIGNAL(timeout()), this, SLOT(Render()));
+
+  simulation_thread_ = new QThread(this);
+  simulation_ = new Simulation();
+  simulation_->moveToThread(simulation_thread_);
+  connect(simulation_, SIGNAL(FrameReady()), this, SLOT(FrameReady()));
+  simulation_thread_->start();
+  simulation_->SetPaused(false);
 }
 
 Scene::~Scene() {
-  delete advancing_timer_;
+  QMetaObject::invokeMethod(simulation_, "Stop",
+                            Qt::BlockingQueuedConnection);
+  simulation_thread_->quit();
+  simulation_thread_->wait();
+  delete simulation_;
+  delete frame_timer_;
   delete creation_line_;
-  foreach (Body *body, body_list_) {
-    body->DeleteTrails();
-    removeItem(body);
-    delete body;
-  }
 }
 
 qreal Scene::GetMass() const {
@@ -92,12 +114,110 @@ void Scene::SetDensity(qreal density) {
   new_density_ = density;
 }
 
+void Scene::SetTestParticle(bool test_particle) {
+  new_test_particle_ = test_particle;
+}
+
+const Frame &Scene::GetFrame() const {
+  return frame_;
+}
+
 void Scene::SetTool(ToolType tool) {
   tool_ = tool;
 }
 
-void Scene::SetTimeStep(qreal time_step) {
-  time_step_ = time_step;
+void Scene::SetTrails(bool trails) {
+  trails_ = trails;
+  QMetaObject::invokeMethod(simulation_, "SetTrails", Qt::QueuedConnection,
+                            Q_ARG(bool, trails_));
+  if (!trails_)
+    trails_item_->Clear();
+}
+
+void Scene::SetLongExposure(bool long_exposure) {
+  long_exposure_ = long_exposure;
+  exposure_item_->Clear();
+  exposure_item_->setVisible(long_exposure_);
+}
+
+void Scene::SetAutoHeatmap(bool auto_heatmap) {
+  auto_heatmap_ = auto_heatmap;
+  UpdateRenderMode();
+}
+
+void Scene::SetHeatmapMassWeighted(bool mass_weighted) {
+  heatmap_item_->SetMassWeighted(mass_weighted);
+  if (heatmap_)
+    heatmap_item_->Sync(frame_);
+}
+
+void Scene::SetViewScale(qreal view_scale) {
+  view_scale_ = view_scale;
+  UpdateRenderMode();
+}
+
+void Scene::SetViewTransform(const QTransform &transform, const QSize &size) {
+  exposure_item_->SetViewTransform(transform, size);
+  heatmap_item_->SetViewTransform(transform, size);
+  if (heatmap_)
+    heatmap_item_->Sync(frame_);
+  visible_rect_ = transform.inverted().mapRect(QRectF(QPointF(0, 0), size));
+  UpdateSceneRect();
+}
+
+void Scene::ShowFrame(const Frame &frame) {
+  const bool count_changed = frame.radii.size() != frame_.radii.size();
+  frame_ = frame;
+  if (count_changed)
+    UpdateRenderMode();
+  // BodiesItem is synchronized even when hidden, because it finds bounding
+  // rectangle of Bodies.
+  bodies_item_->Sync(frame_);
+  if (heatmap_)
+    heatmap_item_->Sync(frame_);
+  if (trails_)
+    trails_item_->Sync(frame_);
+  if (long_exposure_)
+    exposure_item_->Expose(frame_);
+  UpdateSceneRect();
+}
+
+void Scene::UpdateRenderMode() {
+  bool heatmap = false;
+  const int count = frame_.radii.size();
+  if (auto_heatmap_ && count >= kHeatmapMinBodies) {
+    int small_count = 0;
+    foreach (qreal radius, frame_.radii) {
+      if (radius * view_scale_ < kHeatmapRadius)
+        ++small_count;
+    }
+    // Heatmap is used when at least 90% of Bodies are too small.
+    heatmap = small_count * 10 >= count * 9;
+  }
+  if (heatmap != heatmap_) {
+    heatmap_ = heatmap;
+    bodies_item_->setVisible(!heatmap_);
+    heatmap_item_->setVisible(heatmap_);
+    if (heatmap_)
+      heatmap_item_->Sync(frame_);
+  }
+}
+
+void Scene::UpdateSceneRect() {
+  QRectF used(-kMinSceneSize / 2, -kMinSceneSize / 2,
+              kMinSceneSize, kMinSceneSize);
+  if (!frame_.positions.isEmpty())
+    used |= bodies_item_->boundingRect();
+  if (!visible_rect_.isEmpty())
+    used |= visible_rect_;
+  // Changing Scene rectangle moves scroll bars of View, so it is changed only
+  // when something sticks out of it or it is much bigger than needed.
+  QRectF current = sceneRect();
+  QRectF needed = used.adjusted(-used.width() / 2, -used.height() / 2,
+                                used.width() / 2, used.height() / 2);
+  if (!current.contains(used) || current.width() > 4 * needed.width() ||
+      current.height() > 4 * needed.height())
+    setSceneRect(needed);
 }
 
 void Scene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
@@ -108,16 +228,11 @@ void Scene::mousePressEvent(QGraphicsSceneMouseEvent *event) {
     creation_line_->setLine(last_cursor_pos_.x(), last_cursor_pos_.y(),
                             last_cursor_pos_.x(), last_cursor_pos_.y());
   } else if (tool_ == kDelete) {
-    QGraphicsItem *item_under_cursor = itemAt(event->scenePos(), QTransform());
-    if (item_under_cursor != 0) {
-      Body *body = dynamic_cast<Body*>(item_under_cursor);
-      if (body != NULL) {
-        body->DeleteTrails();
-        removeItem(body);
-        body_list_.removeOne(body);
-        delete body;
-      }
-    }
+    // Very small Bodies can be still picked within few pixels from them.
+    QMetaObject::invokeMethod(simulation_, "RemoveBodyAt",
+                              Qt::QueuedConnection,
+                              Q_ARG(QPointF, event->scenePos()),
+                              Q_ARG(qreal, 3.0 / view_scale_));
   }
 }
 
@@ -127,10 +242,9 @@ void Scene::mouseReleaseEvent(QGraphicsSceneMouseEvent *event) {
     QPointF new_velocity = event->scenePos() - last_cursor_pos_;
     Body *body = new Body(new_mass_, new_radius_,
                           new_velocity, last_cursor_pos_);
-    this->addItem(body);
-    body_list_.append(body);
-    if (trails_)
-      body->CreateTrails(view_scale_);
+    body->SetTestParticle(new_test_particle_);
+    QMetaObject::invokeMethod(simulation_, "AddBodies", Qt::QueuedConnection,
+                              Q_ARG(QList<Body*>, QList<Body*>() << body));
   }
 }
 
@@ -142,240 +256,12 @@ void Scene::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
   }
 }
 
-void Scene::AdvanceEuler() {
-  int i = 0;
-  foreach (Body* body_1, body_list_.mid(0, body_list_.count() - 1)) {
-    foreach (Body* body_2, body_list_.mid(1 + i, body_list_.count() - 1 - i)) {
-      qreal delta_x = body_2->pos().x() - body_1->pos().x();
-      qreal delta_y = body_2->pos().y() - body_1->pos().y();
-      qreal distance = sqrt(delta_x * delta_x + delta_y * delta_y);
-      // Eliminates crazy velocities when body was spawned inside another one.
-      if (distance > 0.03) {
-        // Distance is to the power of -3 instead -2, because acceleration
-        // would have to be divided by distance in next lines anyway.
-        qreal acceleration = kGravConstant * time_step_ * pow(distance, -3.0);
-        qreal acceleration_x = acceleration * delta_x;
-        qreal acceleration_y = acceleration * delta_y;
-        qreal force_1_x = acceleration_x * body_2->GetMass();
-        qreal force_1_y = acceleration_y * body_2->GetMass();
-        qreal force_2_x = acceleration_x * body_1->GetMass();
-        qreal force_2_y = acceleration_y * body_1->GetMass();
-        body_1->SetVelocity(body_1->GetVelocity().x() + force_1_x,
-                            body_1->GetVelocity().y() + force_1_y);
-        body_2->SetVelocity(body_2->GetVelocity().x() - force_2_x,
-                            body_2->GetVelocity().y() - force_2_y);
-      }
-      FindCollisions(body_1, body_2, distance);
-    }
-    ++i;
-  }
-
-  foreach (Body* body, body_list_) {
-    body->last_position_ = body->pos();
-    body->setPos(body->pos() + body->GetVelocity() * time_step_);
-    if (trails_)
-      AdvanceTrails(body);
-  }
-}
-
-void Scene::AdvanceRungeKutta() {
-  Body *body = body_list_.last();
-  int i = 0;
-  foreach (Body* body_1, body_list_.mid(0, body_list_.count() - 1)) {
-    body_1->k1dx_ = body_1->GetVelocity() * time_step_;
-    foreach (Body* body_2, body_list_.mid(1 + i, body_list_.count() - 1 - i)) {
-      qreal delta_x = body_2->pos().x() - body_1->pos().x();
-      qreal delta_y = body_2->pos().y() - body_1->pos().y();
-      qreal distance = sqrt(delta_x * delta_x + delta_y * delta_y);
-      // Eliminates crazy velocities when body was spawned inside another one.
-      if (distance > 0.03) {
-        // Distance is to the power of -3 instead -2, because acceleration
-        // would have to be divided by distance in next lines anyway.
-        qreal acceleration = kGravConstant * time_step_ * pow(distance, -3.0);
-        qreal acceleration_x = acceleration * delta_x;
-        qreal acceleration_y = acceleration * delta_y;
-        body_1->k1dv_ += QPointF(acceleration_x * body_2->GetMass(),
-                                 acceleration_y * body_2->GetMass());
-        body_2->k1dv_ += QPointF(-acceleration_x * body_1->GetMass(),
-                                 -acceleration_y * body_1->GetMass());
-      }
-    }
-    ++i;
-  }
-  body->k1dx_ = body->GetVelocity() * time_step_;
-
-  i = 0;
-  foreach (Body* body_1, body_list_.mid(0, body_list_.count() - 1)) {
-    body_1->k2dx_ = time_step_ * (body_1->GetVelocity() + body_1->k1dv_ * 0.5);
-    foreach (Body* body_2, body_list_.mid(1 + i, body_list_.count() - 1 - i)) {
-      qreal pos_1_x = body_1->pos().x() + body_1->k1dx_.x() * 0.5;
-      qreal pos_1_y = body_1->pos().y() + body_1->k1dx_.y() * 0.5;
-      qreal pos_2_x = body_2->pos().x() + body_2->k1dx_.x() * 0.5;
-      qreal pos_2_y = body_2->pos().y() + body_2->k1dx_.y() * 0.5;
-      qreal delta_x = pos_2_x - pos_1_x;
-      qreal delta_y = pos_2_y - pos_1_y;
-      qreal distance = sqrt(delta_x * delta_x + delta_y * delta_y);
-      // Eliminates crazy velocities when body was spawned inside another one.
-      if (distance > 0.03) {
-        // Distance is to the power of -3 instead -2, because acceleration
-        // would have to be divided by distance in next lines anyway.
-        qreal acceleration = kGravConstant * time_step_ * pow(distance, -3.0);
-        qreal acceleration_x = acceleration * delta_x;
-        qreal acceleration_y = acceleration * delta_y;
-        body_1->k2dv_ += QPointF(acceleration_x * body_2->GetMass(),
-                                 acceleration_y * body_2->GetMass());
-        body_2->k2dv_ += QPointF(-acceleration_x * body_1->GetMass(),
-                                 -acceleration_y * body_1->GetMass());
-      }
-    }
-    ++i;
-  }
-  body->k2dx_ = time_step_ * (body->GetVelocity() + body->k1dv_ * 0.5);
-
-  i = 0;
-  foreach (Body* body_1, body_list_.mid(0, body_list_.count() - 1)) {
-    body_1->k3dx_ = time_step_ * (body_1->GetVelocity() + body_1->k2dv_ * 0.5);
-    foreach (Body* body_2, body_list_.mid(1 + i, body_list_.count() - 1 - i)) {
-      qreal pos_1_x = body_1->pos().x() + body_1->k2dx_.x() * 0.5;
-      qreal pos_1_y = body_1->pos().y() + body_1->k2dx_.y() * 0.5;
-      qreal pos_2_x = body_2->pos().x() + body_2->k2dx_.x() * 0.5;
-      qreal pos_2_y = body_2->pos().y() + body_2->k2dx_.y() * 0.5;
-      qreal delta_x = pos_2_x - pos_1_x;
-      qreal delta_y = pos_2_y - pos_1_y;
-      qreal distance = sqrt(delta_x * delta_x + delta_y * delta_y);
-      // Eliminates crazy velocities when body was spawned inside another one.
-      if (distance > 0.03) {
-        // Distance is to the power of -3 instead -2, because acceleration
-        // would have to be divided by distance in next lines anyway.
-        qreal acceleration = kGravConstant * time_step_ * pow(distance, -3.0);
-        qreal acceleration_x = acceleration * delta_x;
-        qreal acceleration_y = acceleration * delta_y;
-        body_1->k3dv_ += QPointF(acceleration_x * body_2->GetMass(),
-                                 acceleration_y * body_2->GetMass());
-        body_2->k3dv_ += QPointF(-acceleration_x * body_1->GetMass(),
-                                 -acceleration_y * body_1->GetMass());
-      }
-    }
-    ++i;
-  }
-  body->k3dx_ = time_step_ * (body->GetVelocity() + body->k2dv_ * 0.5);
-
-  i = 0;
-  foreach (Body* body_1, body_list_.mid(0, body_list_.count() - 1)) {
-    body_1->k4dx_ = time_step_ * (body_1->GetVelocity() + body_1->k3dv_);
-    foreach (Body* body_2, body_list_.mid(1 + i, body_list_.count() - 1 - i)) {
-      qreal pos_1_x = body_1->pos().x() + body_1->k3dx_.x();
-      qreal pos_1_y = body_1->pos().y() + body_1->k3dx_.y();
-      qreal pos_2_x = body_2->pos().x() + body_2->k3dx_.x();
-      qreal pos_2_y = body_2->pos().y() + body_2->k3dx_.y();
-      qreal delta_x = pos_2_x - pos_1_x;
-      qreal delta_y = pos_2_y - pos_1_y;
-      qreal distance = sqrt(delta_x * delta_x + delta_y * delta_y);
-      // Eliminates crazy velocities when body was spawned inside another one.
-      if (distance > 0.03) {
-        // Distance is to the power of -3 instead -2, because acceleration
-        // would have to be divided by distance in next lines anyway.
-        qreal acceleration = kGravConstant * time_step_ * pow(distance, -3.0);
-        qreal acceleration_x = acceleration * delta_x;
-        qreal acceleration_y = acceleration * delta_y;
-        body_1->k4dv_ += QPointF(acceleration_x * body_2->GetMass(),
-                                 acceleration_y * body_2->GetMass());
-        body_2->k4dv_ += QPointF(-acceleration_x * body_1->GetMass(),
-                                 -acceleration_y * body_1->GetMass());
-      }
-      FindCollisions(body_1, body_2, distance);
-    }
-    ++i;
-  }
-  body->k4dx_ = time_step_ * (body->GetVelocity() + body->k3dv_);
-
-  foreach (Body* body, body_list_) {
-    body->last_position_ = body->pos();
-    QPointF delta_velocity = body->k1dv_ + 2.0 * body->k2dv_;
-    delta_velocity += 2.0 * body->k3dv_ + body->k4dv_;
-    delta_velocity /= 6.0;
-    body->SetVelocity(body->GetVelocity() + delta_velocity);
-    QPointF delta_pos = body->k1dx_ + 2.0 * body->k2dx_;
-    delta_pos += 2.0 * body->k3dx_ + body->k4dx_;
-    delta_pos /= 6.0;
-    body->setPos(body->pos() + delta_pos);
-    body->k1dv_ = QPointF(0, 0);
-    body->k2dv_ = QPointF(0, 0);
-    body->k3dv_ = QPointF(0, 0);
-    body->k4dv_ = QPointF(0, 0);
-    if (trails_)
-      AdvanceTrails(body);
-  }
-}
-
-void Scene::FindCollisions(Body* body_1, Body* body_2, qreal distance) {
-  if (distance <= body_1->GetRadius() + body_2->GetRadius()) {
-    if (!collision_list_.contains(body_1))
-      collision_list_.append(body_1);
-    if (!collision_list_.contains(body_2))
-      collision_list_.append(body_2);
-    body_1->colliding_with_.append(body_2);
-    body_2->colliding_with_.append(body_1);
-  }
-}
-
-void Scene::CollidingGroupSearch(Body *body) {
-  foreach (Body *g, body->colliding_with_) {
-    if (!local_collision_list_.contains(g)) {
-      local_collision_list_.append(g);
-      CollidingGroupSearch(g);
-    }
-  }
-  body->colliding_with_.clear();
+void Scene::FrameReady() {
+  // Frames published faster than display rate are skipped.
+  if (!frame_timer_->isActive())
+    frame_timer_->start();
 }
 
-void Scene::ResolveCollisions() {
-  foreach (Body *body, collision_list_) {
-    qreal group_mass_ = 0;
-    qreal group_volume_ = 0;
-    QPointF group_momentum_ = QPointF(0, 0);
-    QPointF group_mass_center_ = QPointF(0, 0);
-    local_collision_list_.append(body);
-    CollidingGroupSearch(body);
-    foreach (Body *colliding_body, local_collision_list_) {
-      qreal colliding_mass = colliding_body->GetMass();
-      // If some Bodies collide together, resulting Body should preserve mass,
-      // volume and momentum.
-      group_mass_ += colliding_mass;
-      group_volume_ += pow(colliding_body->GetRadius(), 3);
-      group_momentum_ += colliding_body->GetVelocity() * colliding_mass;
-      // Position of new Body should be in center of mass of colliding Bodies.
-      group_mass_center_ += colliding_body->pos() * colliding_mass;
-      collision_list_.removeOne(colliding_body);
-      if (colliding_body != body) {
-        colliding_body->DeleteTrails();
-        this->removeItem(colliding_body);
-        body_list_.removeOne(colliding_body);
-      }
-    }
-    body->SetMass(group_mass_);
-    body->SetRadius(cbrt(group_volume_));
-    body->SetVelocity(group_momentum_ / group_mass_);
-    body->setPos(group_mass_center_ / group_mass_);
-    local_collision_list_.clear();
-  }
-}
-
-void Scene::AdvanceTrails(Body *body) {
-  QGraphicsLineItem *trail = body->trails_.at(body->trail_iterator_);
-  trail->setLine(body->last_position_.x(), body->last_position_.y(),
-                 body->pos().x(), body->pos().y());
-  if (body->trail_iterator_ < body->kTrailCount - 1)
-    ++(body->trail_iterator_);
-  else
-    body->trail_iterator_ = 0;
-}
-
-void Scene::Advance() {
-  if (runge_kutta_ && !body_list_.isEmpty())
-    AdvanceRungeKutta();
-  else if (!body_list_.isEmpty())
-    AdvanceEuler();
-
-  ResolveCollisions();
+void Scene::Render() {
+  ShowFrame(simulation_->TakeFrame());
 }
@@ -31,13 +31,21 @@
 #define SCENE_H
 
 #include <QGraphicsScene>
+#include <QThread>
 #include <QTimer>
 
+#include "bodies_item.h"
 #include "body.h"
+#include "exposure_item.h"
+#include "frame.h"
+#include "heatmap_item.h"
+#include "simulation.h"
+#include "trails_item.h"
 
 /**
   * @brief Object that manages graphical objects on screen (e.g. Bodies and
-  *        their trails).
+  *        their trails). Bodies are moved by Simulation in separate thread
+  *        and Scene draws Frames published by it at display rate.
   */
 class Scene : public QGraphicsScene {
   Q_OBJECT
@@ -50,7 +58,14 @@ class Scene : public QGraphicsScene {
     kNone
   };
 
-  static constexpr float kGravConstant = 6673.85;
+  // Shortest interval between drawn Frames [ms].
+  static constexpr int kFrameInterval = 16;
+  // Heatmap is shown instead of Bodies only if there are at least that many.
+  static constexpr int kHeatmapMinBodies = 5000;
+  // Heatmap is shown if most of Bodies have smaller radius on screen [px].
+  static constexpr qreal kHeatmapRadius = 0.5;
+  // Smallest size of Scene.
+  static constexpr qreal kMinSceneSize = 10000.0;
 
   /**
     * @brief Scene constructor.
@@ -60,7 +75,7 @@ class Scene : public QGraphicsScene {
   Scene(QObject *parent = 0, qreal view_scale = 1);
 
   /**
-    * @brief Scene destructor.
+    * @brief Scene destructor. Stops thread of simulation.
     */
   ~Scene();
 
@@ -100,6 +115,19 @@ class Scene : public QGraphicsScene {
     */
   void SetDensity(qreal density);
 
+  /**
+    * @brief Test particle mutator.
+    * @param test_particle Should new Bodies be test particles, which are
+    *        pulled by others without pulling them?
+    */
+  void SetTestParticle(bool test_particle);
+
+  /**
+    * @brief  Frame accessor.
+    * @retval Last drawn state of Bodies.
+    */
+  const Frame &GetFrame() const;
+
   /**
     * @brief Tool mutator.
     * @param tool Function under mouse cursor.
@@ -107,22 +135,70 @@ class Scene : public QGraphicsScene {
   void SetTool(ToolType tool);
 
   /**
-    * @brief Time step mutator.
-    * @param time_step New time step.
+    * @brief Toggles trails behind Bodies.
+    * @param trails Should trails be drawn?
+    */
+  void SetTrails(bool trails);
+
+  /**
+    * @brief Toggles long exposure mode, in which Bodies leave fading traces.
+    * @param long_exposure Should long exposure be shown?
+    */
+  void SetLongExposure(bool long_exposure);
+
+  /**
+    * @brief Allows showing density heatmap when zoomed out.
+    * @param auto_heatmap Should heatmap be shown when Bodies are too small?
+    */
+  void SetAutoHeatmap(bool auto_heatmap);
+
+  /**
+    * @brief Heatmap weighting mutator.
+    * @param mass_weighted Should heatmap show mass instead of number of
+    *        Bodies?
+    */
+  void SetHeatmapMassWeighted(bool mass_weighted);
+
+  /**
+    * @brief Zoom mutator. Chooses between drawing Bodies and heatmap.
+    * @param view_scale Current zoom of View.
+    */
+  void SetViewScale(qreal view_scale);
+
+  /**
+    * @brief Passes mapping of Scene into View to items drawn in viewport
+    *        coordinates.
+    * @param transform Transformation from Scene to viewport coordinates.
+    * @param size Size of viewport.
+    */
+  void SetViewTransform(const QTransform &transform, const QSize &size);
+
+  /**
+    * @brief Passes state of Bodies to items.
+    * @param frame State of Bodies to be drawn.
     */
-  void SetTimeStep(qreal time_step);
+  void ShowFrame(const Frame &frame);
 
-  // Timer for advancing Scene in equal time intervals.
-  QTimer *advancing_timer_;
+  // Simulation which moves Bodies.
+  Simulation *simulation_;
   // Line used during creation of new Body. Visualizes its velocity.
   QGraphicsLineItem *creation_line_;
-  QList<Body*> body_list_;
+  // Item which draws all Bodies.
+  BodiesItem *bodies_item_;
+  // Item which draws trails of all Bodies.
+  TrailsItem *trails_item_;
+  // Item which accumulates positions of Bodies in long exposure mode.
+  ExposureItem *exposure_item_;
+  // Item which draws density of Bodies when they are smaller than pixel.
+  HeatmapItem *heatmap_item_;
   // Are trails activated?
   bool trails_;
-  // Euler or Runge-Kutta method?
-  bool runge_kutta_;
+  // Is long exposure activated?
+  bool long_exposure_;
   // Current zoom of View.
   qreal view_scale_;
+  // Is heatmap drawn instead of Bodies?
+  bool heatmap_;
 
  protected:
   /**
@@ -146,61 +222,47 @@ class Scene : public QGraphicsScene {
 
  private:
   /**
-    * @brief Updates velocity and position of Bodies using Euler method.
-    */
-  void AdvanceEuler();
-
-  /**
-    * @brief Updates velocity and position of Bodies using Runge-Kutta method.
-    */
-  void AdvanceRungeKutta();
-
-  /**
-    * @brief Find collision between Bodies.
-    * @param body_1 Body 1.
-    * @param body_2 Body 2.
-    * @param distance Distance between Bodies.
-    */
-  void FindCollisions(Body* body_1, Body* body_2, qreal distance);
-
-  /**
-    * @brief Finds all Bodies colliding with each other,
-    *        creating local collision group.
-    * @param body Reference Body.
-    */
-  void CollidingGroupSearch(Body *body);
-
-  /**
-    * @brief Merges Bodies together if collision occurred.
+    * @brief Shows heatmap instead of Bodies if most of them are smaller than
+    *        pixel.
     */
-  void ResolveCollisions();
+  void UpdateRenderMode();
 
   /**
-    * @brief Updates trails of Body.
-    * @param body Body.
+    * @brief Fits Scene rectangle to Bodies and visible area, so View can be
+    *        moved around them.
     */
-  void AdvanceTrails(Body *body);
+  void UpdateSceneRect();
 
+  // Thread in which simulation runs.
+  QThread *simulation_thread_;
+  // Timer which limits drawing to display rate.
+  QTimer *frame_timer_;
+  // Last drawn state of Bodies.
+  Frame frame_;
   // Parameters used for creating new Body.
   qreal new_mass_;
   qreal new_density_;
   qreal new_radius_;
+  bool new_test_particle_;
   // Current function under mouse cursor.
   ToolType tool_;
   // Position of new Body. Used during its creation.
   QPointF last_cursor_pos_;
-  // All Bodies which are currently colliding.
-  QList<Body*> collision_list_;
-  // Bodies which are currently colliding with each other in local group.
-  QList<Body*> local_collision_list_;
-  // Time step used in calculations of positon and velocity of Bodies.
-  qreal time_step_;
+  // Can heatmap be shown when zoomed out?
+  bool auto_heatmap_;
+  // Part of Scene visible in View.
+  QRectF visible_rect_;
 
  private slots:
   /**
-    * @brief Updates velocity and position of Bodies.
+    * @brief Schedules drawing of new Frame.
+    */
+  void FrameReady();
+
+  /**
+    * @brief Takes last Frame from Simulation and shows it.
     */
-  void Advance();
+  void Render();
 };
 
 #endif // SCENE_H
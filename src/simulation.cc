@@ -0,0 +1,755 @@
+/**
+  ******************************************************************************
+  * @file    simulation.cc
+  * @author  Karol Leszczyński
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Simulation class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "simulation.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "direct_solver.h"
+#include "dormand_prince_integrator.h"
+#include "euler_integrator.h"
+#include "hilbert_curve.h"
+#include "numa_placement.h"
+#include "runge_kutta_integrator.h"
+#include "softening_kernels.h"
+#include "tree_solver.h"
+#include "wisdom_holman_integrator.h"
+
+/**
+  * @brief  Compares ids of Bodies.
+  * @param  body_1 Body 1.
+  * @param  body_2 Body 2.
+  * @retval Is id of Body 1 lower?
+  */
+static bool IdLess(const Body *body_1, const Body *body_2) {
+  return body_1->GetId() < body_2->GetId();
+}
+
+/**
+  * @brief  Creates Stepper with given integration policy and forces summed
+  *         in Scalar with given Kernel.
+  * @param  solver Way of summing gravitational forces.
+  * @param  softening_length Softening length of Kernel.
+  * @param  pool Threads which sum forces.
+  * @retval New Stepper.
+  */
+template <template <class> class Integrator, typename Scalar,
+          template <typename> class Kernel>
+static Stepper *CreateStepper(Simulation::Solver solver,
+                              qreal softening_length, WorkerPool *pool) {
+  if (solver == Simulation::kTree) {
+    return new PolicyStepper<Integrator, TreeSolver<Scalar, Kernel> >(
+        Simulation::kGravConstant, softening_length, pool);
+  }
+  return new PolicyStepper<Integrator, DirectSolver<Scalar, Kernel> >(
+      Simulation::kGravConstant, softening_length, pool);
+}
+
+/**
+  * @brief  Creates Stepper with given integration policy and forces summed
+  *         in Scalar.
+  * @param  solver Way of summing gravitational forces.
+  * @param  softening Shape of gravity at short distances.
+  * @param  softening_length Softening length of Plummer and spline kernels.
+  * @param  pool Threads which sum forces.
+  * @retval New Stepper.
+  */
+template <template <class> class Integrator, typename Scalar>
+static Stepper *CreateStepper(Simulation::Solver solver,
+                              Simulation::Softening softening,
+                              qreal softening_length, WorkerPool *pool) {
+  switch (softening) {
+    case Simulation::kPlummer:
+      return CreateStepper<Integrator, Scalar, PlummerKernel>(
+          solver, softening_length, pool);
+    case Simulation::kSpline:
+      return CreateStepper<Integrator, Scalar, SplineKernel>(
+          solver, softening_length, pool);
+    default:
+      return CreateStepper<Integrator, Scalar, CutoffKernel>(
+          solver, Simulation::kMinDistance, pool);
+  }
+}
+
+/**
+  * @brief  Creates Stepper with given integration policy.
+  * @param  precision Precision of calculations of gravitational forces.
+  * @param  solver Way of summing gravitational forces.
+  * @param  softening Shape of gravity at short distances.
+  * @param  softening_length Softening length of Plummer and spline kernels.
+  * @param  pool Threads which sum forces.
+  * @retval New Stepper.
+  */
+template <template <class> class Integrator>
+static Stepper *CreateStepper(Simulation::Precision precision,
+                              Simulation::Solver solver,
+                              Simulation::Softening softening,
+                              qreal softening_length, WorkerPool *pool) {
+  if (precision == Simulation::kSinglePrecision) {
+    return CreateStepper<Integrator, float>(solver, softening,
+                                            softening_length, pool);
+  }
+  return CreateStepper<Integrator, double>(solver, softening,
+                                           softening_length, pool);
+}
+
+/**
+  * @brief  Creates Stepper of given configuration.
+  * @param  method Method of integration of motion.
+  * @param  precision Precision of calculations of gravitational forces.
+  * @param  solver Way of summing gravitational forces.
+  * @param  softening Shape of gravity at short distances.
+  * @param  softening_length Softening length of Plummer and spline kernels.
+  * @param  pool Threads which sum forces.
+  * @retval New Stepper.
+  */
+static Stepper *CreateStepper(Simulation::Method method,
+                              Simulation::Precision precision,
+                              Simulation::Solver solver,
+                              Simulation::Softening softening,
+                              qreal softening_length, WorkerPool *pool) {
+  // Every combination of policies is compiled separately.
+  switch (method) {
+    case Simulation::kRungeKutta:
+      return CreateStepper<RungeKuttaIntegrator>(
+          precision, solver, softening, softening_length, pool);
+    case Simulation::kWisdomHolman:
+      return CreateStepper<WisdomHolmanIntegrator>(
+          precision, solver, softening, softening_length, pool);
+    case Simulation::kDormandPrince:
+      return CreateStepper<DormandPrinceIntegrator>(
+          precision, solver, softening, softening_length, pool);
+    default:
+      return CreateStepper<EulerIntegrator>(
+          precision, solver, softening, softening_length, pool);
+  }
+}
+
+/**
+  * @brief  Sums potential of every pair of Bodies.
+  * @param  bodies Bodies.
+  * @param  kernel Softening kernel.
+  * @retval Potential energy before multiplying by gravitational constant.
+  */
+template <class Kernel>
+static qreal SumPotential(const QList<Body*> &bodies, const Kernel &kernel) {
+  qreal potential = 0.0;
+  const int count = bodies.count();
+  for (int i = 0; i < count; ++i) {
+    const Body *body_1 = bodies.at(i);
+    for (int j = i + 1; j < count; ++j) {
+      const Body *body_2 = bodies.at(j);
+      // Test particles do not interact with each other.
+      if (body_1->IsTestParticle() && body_2->IsTestParticle())
+        continue;
+      const QPointF delta = body_2->GetPosition() - body_1->GetPosition();
+      potential += body_1->GetMass() * body_2->GetMass() *
+                   kernel.Potential(delta.x() * delta.x() +
+                                    delta.y() * delta.y());
+    }
+  }
+  return potential;
+}
+
+Simulation::Simulation(QObject *parent, int thread_count)
+    : QObject(parent),
+      next_id_(1),
+      time_step_(1.0),
+      method_(kEuler),
+      tolerance_(kDefaultTolerance),
+      precision_(kDoublePrecision),
+      solver_(kDirect),
+      softening_(kCutoff),
+      softening_length_(kDefaultSofteningLength),
+      stepper_(NULL),
+      pool_(new WorkerPool(thread_count)),
+      node_count_(GetNumaNodeCount()),
+      thread_count_(thread_count),
+      pinned_(false),
+      autotune_(false),
+      deterministic_(false),
+      state_hash_(0),
+      regularizer_(kGravConstant, kMinDistance),
+      trails_(false),
+      trail_length_(Body::kDefaultTrailLength),
+      frame_wanted_(1),
+      step_(0),
+      time_(0.0),
+      export_queue_(NULL) {
+  // Timer is child of Simulation, so it is moved to its thread together
+  // with it.
+  advancing_timer_ = new QTimer(this);
+  connect(advancing_timer_, SIGNAL(timeout()), this, SLOT(Advance()));
+  // Arguments of mutators invoked from window are copied into queued
+  // events, which needs their types to be known.
+  qRegisterMetaType<Simulation::Method>("Simulation::Method");
+  qRegisterMetaType<Simulation::Precision>("Simulation::Precision");
+  qRegisterMetaType<Simulation::Solver>("Simulation::Solver");
+  qRegisterMetaType<Simulation::Softening>("Simulation::Softening");
+  qRegisterMetaType<QList<Body*> >("QList<Body*>");
+  SelectStepper();
+}
+
+Simulation::~Simulation() {
+  foreach (Body *body, body_list_)
+    delete body;
+  delete stepper_;
+  delete pool_;
+}
+
+void Simulation::SetPaused(bool paused) {
+  // Timer can be started and stopped only from thread of simulation.
+  QMetaObject::invokeMethod(this, paused ? "Stop" : "Start");
+}
+
+void Simulation::SetTimeStep(qreal time_step) {
+  QMutexLocker locker(&mutex_);
+  time_step_ = time_step;
+}
+
+void Simulation::SetMethod(Method method) {
+  QMutexLocker locker(&mutex_);
+  method_ = method;
+  tuner_.Reset();
+  SelectStepper();
+}
+
+void Simulation::SetTolerance(qreal tolerance) {
+  QMutexLocker locker(&mutex_);
+  tolerance_ = tolerance;
+  stepper_->SetTolerance(tolerance_);
+}
+
+void Simulation::SetPrecision(Precision precision) {
+  QMutexLocker locker(&mutex_);
+  precision_ = precision;
+  SelectStepper();
+}
+
+void Simulation::SetSolver(Solver solver) {
+  QMutexLocker locker(&mutex_);
+  solver_ = solver;
+  SelectStepper();
+}
+
+void Simulation::SetSoftening(Softening softening) {
+  QMutexLocker locker(&mutex_);
+  softening_ = softening;
+  tuner_.Reset();
+  SelectStepper();
+}
+
+void Simulation::SetSofteningLength(qreal length) {
+  QMutexLocker locker(&mutex_);
+  softening_length_ = length;
+  tuner_.Reset();
+  SelectStepper();
+}
+
+void Simulation::SetThreadCount(int thread_count) {
+  QMutexLocker locker(&mutex_);
+  thread_count_ = thread_count;
+  delete pool_;
+  pool_ = new WorkerPool(thread_count_, pinned_);
+  tuner_.Reset();
+  SelectStepper();
+}
+
+void Simulation::SetThreadPinning(bool pinned) {
+  QMutexLocker locker(&mutex_);
+  pinned_ = pinned;
+  delete pool_;
+  pool_ = new WorkerPool(thread_count_, pinned_);
+  tuner_.Reset();
+  SelectStepper();
+}
+
+void Simulation::SetAutoTune(bool autotune) {
+  QMutexLocker locker(&mutex_);
+  autotune_ = autotune;
+  tuner_.Reset();
+}
+
+void Simulation::SetTuningAccuracy(qreal accuracy) {
+  QMutexLocker locker(&mutex_);
+  tuner_.SetAccuracy(accuracy);
+}
+
+void Simulation::SetDeterministic(bool deterministic) {
+  QMutexLocker locker(&mutex_);
+  deterministic_ = deterministic;
+  state_hash_ = 0;
+}
+
+quint64 Simulation::GetStateHash() {
+  QMutexLocker locker(&mutex_);
+  return state_hash_;
+}
+
+void Simulation::SetTrails(bool trails) {
+  QMutexLocker locker(&mutex_);
+  trails_ = trails;
+  foreach (Body *body, body_list_) {
+    body->SetTrailLength(trails_ ? trail_length_ : 0);
+    body->ClearTrail();
+  }
+  Publish(true);
+}
+
+void Simulation::SetTrailLength(int length) {
+  QMutexLocker locker(&mutex_);
+  trail_length_ = length;
+  if (trails_) {
+    foreach (Body *body, body_list_)
+      body->SetTrailLength(trail_length_);
+    Publish(true);
+  }
+}
+
+void Simulation::AddBody(Body *body) {
+  AddBodies(QList<Body*>() << body);
+}
+
+void Simulation::AddBodies(const QList<Body*> &bodies) {
+  QMutexLocker locker(&mutex_);
+  foreach (Body *body, bodies) {
+    body->SetId(next_id_++);
+    body_list_.append(body);
+    if (trails_)
+      body->SetTrailLength(trail_length_);
+  }
+  Publish(true);
+}
+
+bool Simulation::RemoveBodyAt(QPointF position, qreal min_radius) {
+  QMutexLocker locker(&mutex_);
+  for (int i = body_list_.count() - 1; i >= 0; --i) {
+    Body *body = body_list_.at(i);
+    QPointF delta = body->GetPosition() - position;
+    qreal radius = std::max(body->GetRadius(), min_radius);
+    if (delta.x() * delta.x() + delta.y() * delta.y() <= radius * radius) {
+      body_list_.removeAt(i);
+      delete body;
+      Publish(true);
+      return true;
+    }
+  }
+  return false;
+}
+
+void Simulation::Clear() {
+  QMutexLocker locker(&mutex_);
+  foreach (Body *body, body_list_)
+    delete body;
+  body_list_.clear();
+  Publish(true);
+}
+
+bool Simulation::SetSnapshots(const QString &name) {
+  QMutexLocker locker(&mutex_);
+  if (name.isEmpty()) {
+    snapshot_writer_.Close();
+    return false;
+  }
+  if (!snapshot_writer_.Open(name)) {
+    emit SnapshotsFailed();
+    return false;
+  }
+  // Readers get current state even if simulation is paused.
+  snapshot_writer_.Write(step_, time_, body_list_);
+  return true;
+}
+
+void Simulation::SetExportQueue(BoundedQueue<Frame> *queue) {
+  export_queue_ = queue;
+}
+
+void Simulation::Run(int step_count) {
+  QMutexLocker locker(&mutex_);
+  for (int i = 0; i < step_count; ++i)
+    Step();
+}
+
+int Simulation::GetBodyCount() {
+  QMutexLocker locker(&mutex_);
+  return body_list_.count();
+}
+
+qreal Simulation::GetEnergy() {
+  QMutexLocker locker(&mutex_);
+  qreal kinetic = 0.0;
+  foreach (const Body *body, body_list_) {
+    const QPointF velocity = body->GetVelocity();
+    kinetic += 0.5 * body->GetMass() *
+               (velocity.x() * velocity.x() + velocity.y() * velocity.y());
+  }
+  // Potential has the same shape as forces.
+  qreal potential;
+  switch (softening_) {
+    case kPlummer:
+      potential = SumPotential(body_list_,
+                               PlummerKernel<qreal>(softening_length_));
+      break;
+    case kSpline:
+      potential = SumPotential(body_list_,
+                               SplineKernel<qreal>(softening_length_));
+      break;
+    default:
+      potential = SumPotential(body_list_, CutoffKernel<qreal>(kMinDistance));
+      break;
+  }
+  return kinetic + kGravConstant * potential;
+}
+
+QVector<qint64> Simulation::GetNodeBytes() {
+  QMutexLocker locker(&mutex_);
+  QVector<qint64> node_bytes;
+  stepper_->CountNodeBytes(&node_bytes);
+  return node_bytes;
+}
+
+Frame Simulation::TakeFrame() {
+  QMutexLocker locker(&frame_mutex_);
+  frame_wanted_.storeRelease(1);
+  return frame_;
+}
+
+void Simulation::Start() {
+  advancing_timer_->start(kStepInterval);
+}
+
+void Simulation::Stop() {
+  advancing_timer_->stop();
+}
+
+void Simulation::SelectStepper() {
+  delete stepper_;
+  stepper_ = CreateStepper(method_, precision_, solver_, softening_,
+                           softening_length_, pool_);
+  stepper_->SetTolerance(tolerance_);
+}
+
+void Simulation::Tune() {
+  // Candidates integrate with the same method and softening as stepper_.
+  const AutoTuner::Factory factory = [this](const AutoTuner::Config &config,
+                                            WorkerPool *pool) {
+    Stepper *stepper = CreateStepper(
+        method_, config.single_precision ? kSinglePrecision
+                                         : kDoublePrecision,
+        config.tree ? kTree : kDirect, softening_, softening_length_, pool);
+    stepper->SetTolerance(tolerance_);
+    return stepper;
+  };
+  const QString policies = QString("%1-%2-%3").arg(method_).arg(softening_)
+                                              .arg(softening_length_);
+  const AutoTuner::Config config = tuner_.Tune(
+      policies, factory, thread_count_, time_step_, ids_, masses_,
+      positions_, velocities_);
+  solver_ = config.tree ? kTree : kDirect;
+  precision_ = config.single_precision ? kSinglePrecision : kDoublePrecision;
+  if (config.thread_count != pool_->GetThreadCount()) {
+    delete pool_;
+    pool_ = new WorkerPool(config.thread_count, pinned_);
+  }
+  SelectStepper();
+}
+
+void Simulation::ReorderBodies() {
+  const int count = body_list_.count();
+  if (count < 2)
+    return;
+  qreal left = body_list_.first()->GetPosition().x();
+  qreal right = left;
+  qreal top = body_list_.first()->GetPosition().y();
+  qreal bottom = top;
+  foreach (const Body *body, body_list_) {
+    const QPointF position = body->GetPosition();
+    left = std::min(left, position.x());
+    right = std::max(right, position.x());
+    top = std::min(top, position.y());
+    bottom = std::max(bottom, position.y());
+  }
+  const qreal size = std::max(right - left, bottom - top);
+  if (!(size > 0.0))
+    return;
+  // Bounding square of Bodies is divided into grid of curve.
+  const qreal scale = ((1 << kHilbertOrder) - 1) / size;
+  curve_order_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    Body *body = body_list_.at(i);
+    const QPointF position = body->GetPosition();
+    const quint32 column = static_cast<quint32>((position.x() - left) * scale);
+    const quint32 row = static_cast<quint32>((position.y() - top) * scale);
+    curve_order_[i] = std::make_pair(HilbertIndex(column, row), body);
+  }
+  // Bodies in the same cell keep their order, so result does not depend on
+  // implementation of sorting.
+  std::stable_sort(curve_order_.begin(), curve_order_.end(),
+                   [](const std::pair<quint32, Body*> &a,
+                      const std::pair<quint32, Body*> &b) {
+    return a.first < b.first;
+  });
+  for (int i = 0; i < count; ++i)
+    body_list_[i] = curve_order_.at(i).second;
+}
+
+void Simulation::SweepCollisions() {
+  const int count = body_list_.count();
+  radii_.resize(count);
+  for (int i = 0; i < count; ++i)
+    radii_[i] = body_list_.at(i)->GetRadius();
+  neighbor_list_.Update(time_step_, ids_, positions_, velocities_, radii_);
+  const QVector<std::pair<int, int> > &pairs = neighbor_list_.GetPairs();
+  for (int p = 0; p < pairs.size(); ++p) {
+    const int i = pairs.at(p).first;
+    const int j = pairs.at(p).second;
+    const QPointF delta = positions_.at(j) - positions_.at(i);
+    qreal distance = sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+    FindCollisions(body_list_.at(i), body_list_.at(j), distance);
+  }
+}
+
+void Simulation::FindCollisions(Body* body_1, Body* body_2, qreal distance) {
+  if (distance <= body_1->GetRadius() + body_2->GetRadius()) {
+    if (!collision_list_.contains(body_1))
+      collision_list_.append(body_1);
+    if (!collision_list_.contains(body_2))
+      collision_list_.append(body_2);
+    body_1->colliding_with_.append(body_2);
+    body_2->colliding_with_.append(body_1);
+  }
+}
+
+void Simulation::CollidingGroupSearch(Body *body) {
+  foreach (Body *g, body->colliding_with_) {
+    if (!local_collision_list_.contains(g)) {
+      local_collision_list_.append(g);
+      CollidingGroupSearch(g);
+    }
+  }
+  body->colliding_with_.clear();
+}
+
+void Simulation::ResolveCollisions() {
+  // Group is merged into its Body with the lowest id and its members are
+  // summed in order of ids, so result does not depend on order of Bodies.
+  if (deterministic_)
+    std::sort(collision_list_.begin(), collision_list_.end(), IdLess);
+  // Every group removes all its members from list.
+  while (!collision_list_.isEmpty()) {
+    Body *body = collision_list_.first();
+    qreal group_mass_ = 0;
+    qreal group_volume_ = 0;
+    QPointF group_momentum_ = QPointF(0, 0);
+    QPointF group_mass_center_ = QPointF(0, 0);
+    bool group_test_particle = true;
+    local_collision_list_.append(body);
+    CollidingGroupSearch(body);
+    if (deterministic_) {
+      std::sort(local_collision_list_.begin(), local_collision_list_.end(),
+                IdLess);
+    }
+    // Test particles absorbed by regular Bodies add nothing to them. Group
+    // of test particles only merges into bigger test particle.
+    foreach (const Body *colliding_body, local_collision_list_)
+      group_test_particle &= colliding_body->IsTestParticle();
+    foreach (Body *colliding_body, local_collision_list_) {
+      const bool absorbed =
+          !group_test_particle && colliding_body->IsTestParticle();
+      qreal colliding_mass = absorbed ? 0.0 : colliding_body->GetMass();
+      // If some Bodies collide together, resulting Body should preserve mass,
+      // volume and momentum.
+      group_mass_ += colliding_mass;
+      if (!absorbed)
+        group_volume_ += pow(colliding_body->GetRadius(), 3);
+      group_momentum_ += colliding_body->GetVelocity() * colliding_mass;
+      // Position of new Body should be in center of mass of colliding Bodies.
+      group_mass_center_ += colliding_body->GetPosition() * colliding_mass;
+      collision_list_.removeOne(colliding_body);
+      // Other Bodies are absorbed. Their memory returns to pool.
+      if (colliding_body != body) {
+        body_list_.removeOne(colliding_body);
+        delete colliding_body;
+      }
+    }
+    body->SetMass(group_mass_);
+    body->SetRadius(cbrt(group_volume_));
+    body->SetVelocity(group_momentum_ / group_mass_);
+    body->SetPosition(group_mass_center_ / group_mass_);
+    body->SetTestParticle(group_test_particle);
+    local_collision_list_.clear();
+  }
+}
+
+void Simulation::Step() {
+  // Bodies are identified by their ids, so their order can change freely.
+  if (step_ % kReorderInterval == 0)
+    ReorderBodies();
+  const int count = body_list_.count();
+  positions_.resize(count);
+  velocities_.resize(count);
+  masses_.resize(count);
+  ids_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    const Body *body = body_list_.at(i);
+    positions_[i] = body->GetPosition();
+    velocities_[i] = body->GetVelocity();
+    // Test particles are left out of sources of gravity.
+    masses_[i] = body->IsTestParticle() ? 0.0 : body->GetMass();
+    ids_[i] = body->GetId();
+  }
+  // Timings would make results depend on machine in deterministic mode.
+  if (autotune_ && !deterministic_ && tuner_.IsDue(count))
+    Tune();
+  // Collisions are found at positions from beginning of step.
+  SweepCollisions();
+  // Tight pairs move along Kepler orbits around their barycenters, which
+  // are advanced by stepper with other Bodies.
+  // Softened gravity is not Keplerian at short distances, so pairs stay
+  // with other Bodies then.
+  if (softening_ == kCutoff)
+    regularizer_.Update(step_ % BinaryRegularizer::kSearchInterval == 0,
+                        time_step_, ids_, masses_, positions_, velocities_);
+  if (softening_ != kCutoff || regularizer_.IsEmpty()) {
+    stepper_->SetIds(ids_);
+    stepper_->Advance(time_step_, masses_, &positions_, &velocities_);
+  } else {
+    regularizer_.Join(time_step_, ids_, masses_, positions_, velocities_,
+                      &bulk_ids_, &bulk_masses_, &bulk_positions_,
+                      &bulk_velocities_);
+    stepper_->SetIds(bulk_ids_);
+    stepper_->Advance(time_step_, bulk_masses_, &bulk_positions_,
+                      &bulk_velocities_);
+    regularizer_.Split(time_step_, masses_, bulk_positions_,
+                       bulk_velocities_, &positions_, &velocities_);
+  }
+  // Asking kernel about every page takes time, so it is done rarely.
+  if (node_count_ > 1 && step_ % kNodeSampleInterval == 0) {
+    node_bytes_.clear();
+    stepper_->CountNodeBytes(&node_bytes_);
+  }
+  for (int i = 0; i < count; ++i) {
+    Body *body = body_list_.at(i);
+    body->SetPosition(positions_.at(i));
+    body->SetVelocity(velocities_.at(i));
+  }
+  if (trails_) {
+    foreach (Body *body, body_list_)
+      body->RecordTrail();
+  }
+
+  ResolveCollisions();
+  ++step_;
+  time_ += time_step_;
+  if (deterministic_) {
+    // Hashes of Bodies are added, so order of Bodies does not matter.
+    state_hash_ = step_;
+    foreach (const Body *body, body_list_)
+      state_hash_ += body->GetStateHash();
+  }
+  if (snapshot_writer_.IsOpen())
+    snapshot_writer_.Write(step_, time_, body_list_);
+}
+
+Frame Simulation::BuildFrame() const {
+  Frame frame;
+  const int count = body_list_.count();
+  frame.positions.resize(count);
+  frame.radii.resize(count);
+  frame.masses.resize(count);
+  frame.ids.resize(count);
+  frame.state_hash = state_hash_;
+  frame.reserved_bytes = Body::GetReservedBytes();
+  frame.node_bytes = node_bytes_;
+  frame.tree = solver_ == kTree;
+  frame.single_precision = precision_ == kSinglePrecision;
+  frame.thread_count = pool_->GetThreadCount();
+  for (int i = 0; i < count; ++i) {
+    const Body *body = body_list_.at(i);
+    frame.positions[i] = body->GetPosition();
+    frame.radii[i] = body->GetRadius();
+    frame.masses[i] = body->GetMass();
+    frame.ids[i] = body->GetId();
+    frame.memory_bytes += body->GetPooledBytes();
+  }
+  if (trails_) {
+    frame.trail_offsets.resize(count + 1);
+    int total = 0;
+    for (int i = 0; i < count; ++i) {
+      frame.trail_offsets[i] = total;
+      total += body_list_.at(i)->GetTrailSize();
+    }
+    frame.trail_offsets[count] = total;
+    frame.trail_points.resize(total);
+    for (int i = 0; i < count; ++i) {
+      const Body *body = body_list_.at(i);
+      QPointF *points = frame.trail_points.data() + frame.trail_offsets.at(i);
+      for (int j = 0; j < body->GetTrailSize(); ++j)
+        points[j] = body->GetTrailPoint(j);
+    }
+  }
+  return frame;
+}
+
+void Simulation::Publish(bool force) {
+  // Nobody would look at Frame published before previous one was taken.
+  if (!frame_wanted_.testAndSetOrdered(1, 0) && !force)
+    return;
+
+  Frame frame = BuildFrame();
+  {
+    QMutexLocker locker(&frame_mutex_);
+    frame_ = frame;
+  }
+  emit FrameReady();
+}
+
+void Simulation::Advance() {
+  QMutexLocker locker(&mutex_);
+  Step();
+  Publish(false);
+}
+
+void Simulation::Export(int frame_count, int cadence) {
+  for (int i = 0; i < frame_count; ++i) {
+    Frame frame;
+    {
+      QMutexLocker locker(&mutex_);
+      // First Frame shows initial state.
+      for (int j = 0; i > 0 && j < cadence; ++j)
+        Step();
+      frame = BuildFrame();
+    }
+    // Waits only if drawing falls behind. Files are written by other
+    // threads further down the pipeline.
+    if (!export_queue_->Push(frame))
+      return;
+  }
+}
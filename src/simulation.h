@@ -0,0 +1,496 @@
+/**
+  ******************************************************************************
+  * @file    simulation.h
+  * @author  Karol Leszczyński
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of Simulation class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <QAtomicInt>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <utility>
+
+#include "auto_tuner.h"
+#include "binary_regularizer.h"
+#include "body.h"
+#include "bounded_queue.h"
+#include "frame.h"
+#include "neighbor_list.h"
+#include "snapshot_writer.h"
+#include "stepper.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Object that moves Bodies. It lives in its own thread, so slow steps
+  *        do not stop drawing. State of Bodies is published as Frame only
+  *        when previous one was taken. Window invokes its mutators through
+  *        queued connections, so they run between steps and never wait for
+  *        one.
+  */
+class Simulation : public QObject {
+  Q_OBJECT
+
+ public:
+  // Methods of integration of motion.
+  enum Method {
+    kEuler,
+    kRungeKutta,
+    // Bodies move along Kepler orbits around the most massive one, so much
+    // longer time steps are possible in planetary systems.
+    kWisdomHolman,
+    // Adaptive method, which divides time step into substeps as required
+    // by tolerance.
+    kDormandPrince
+  };
+
+  // Precision of calculations of gravitational forces.
+  enum Precision {
+    kDoublePrecision,
+    // Forces are summed in single precision with compensation, relative to
+    // center of mass. Velocities and positions are kept in double.
+    kSinglePrecision
+  };
+
+  // Way of summing gravitational forces.
+  enum Solver {
+    // Every pair of Bodies, exact but quadratic in their number.
+    kDirect,
+    // Barnes-Hut quadtree, which approximates distant groups of Bodies.
+    kTree
+  };
+
+  // Shape of gravity at short distances.
+  enum Softening {
+    // Newtonian gravity, cut off below kMinDistance.
+    kCutoff,
+    // Bodies pull each other as spheres of softening length, which suits
+    // collisionless systems. Close pairs are not regularized then.
+    kPlummer,
+    // Like Plummer, but exactly Newtonian beyond 2.8 softening lengths.
+    kSpline
+  };
+
+  static constexpr qreal kGravConstant = 6673.85;
+  // Bodies closer than that do not pull each other. Eliminates crazy
+  // velocities when Body was spawned inside another one.
+  static constexpr qreal kMinDistance = 0.03;
+  // Default softening length of Plummer and spline softening.
+  static constexpr qreal kDefaultSofteningLength = 5.0;
+  // Default tolerance of adaptive method.
+  static constexpr qreal kDefaultTolerance = 1e-8;
+  // Interval between steps [ms].
+  static constexpr int kStepInterval = 10;
+  // Number of steps between sorting Bodies along Hilbert curve.
+  static constexpr int kReorderInterval = 64;
+  // Number of steps between finding where force arrays are placed.
+  static constexpr int kNodeSampleInterval = 256;
+
+  /**
+    * @brief Simulation constructor.
+    * @param parent Parent of object.
+    * @param thread_count Number of threads summing forces. Value 0 means
+    *        number of processor cores.
+    */
+  Simulation(QObject *parent = 0, int thread_count = 0);
+
+  /**
+    * @brief Simulation destructor.
+    */
+  ~Simulation();
+
+  /**
+    * @brief Pauses or resumes simulation.
+    * @param paused Should simulation be paused?
+    */
+  void SetPaused(bool paused);
+
+  /**
+    * @brief Time step mutator.
+    * @param time_step New time step.
+    */
+  Q_INVOKABLE void SetTimeStep(qreal time_step);
+
+  /**
+    * @brief Method mutator.
+    * @param method Method of integration of motion.
+    */
+  Q_INVOKABLE void SetMethod(Simulation::Method method);
+
+  /**
+    * @brief Tolerance mutator.
+    * @param tolerance Largest error of one substep of adaptive method,
+    *        relative to position and velocity of Body.
+    */
+  Q_INVOKABLE void SetTolerance(qreal tolerance);
+
+  /**
+    * @brief Precision mutator.
+    * @param precision Precision of calculations of gravitational forces.
+    */
+  Q_INVOKABLE void SetPrecision(Simulation::Precision precision);
+
+  /**
+    * @brief Solver mutator.
+    * @param solver Way of summing gravitational forces.
+    */
+  Q_INVOKABLE void SetSolver(Simulation::Solver solver);
+
+  /**
+    * @brief Softening mutator.
+    * @param softening Shape of gravity at short distances.
+    */
+  Q_INVOKABLE void SetSoftening(Simulation::Softening softening);
+
+  /**
+    * @brief Softening length mutator.
+    * @param length Softening length of Plummer and spline softening.
+    */
+  Q_INVOKABLE void SetSofteningLength(qreal length);
+
+  /**
+    * @brief Number of threads mutator.
+    * @param thread_count Number of threads summing forces. Value 0 means
+    *        number of processor cores. With automatic tuning it is the
+    *        largest number tried.
+    */
+  Q_INVOKABLE void SetThreadCount(int thread_count);
+
+  /**
+    * @brief Toggles pinning of threads summing forces to processor cores.
+    *        Each thread then works on the same Bodies every step and their
+    *        arrays are allocated on its NUMA node.
+    * @param pinned Should threads be pinned?
+    */
+  Q_INVOKABLE void SetThreadPinning(bool pinned);
+
+  /**
+    * @brief Toggles automatic tuning, which chooses solver, precision and
+    *        number of threads by timing them on current Bodies. Tuning
+    *        repeats when number of Bodies changes significantly. It is
+    *        skipped in deterministic mode, as timings are not reproducible.
+    * @param autotune Should solver, precision and threads be chosen
+    *        automatically?
+    */
+  Q_INVOKABLE void SetAutoTune(bool autotune);
+
+  /**
+    * @brief Tuning accuracy mutator.
+    * @param accuracy Largest relative error of velocity changes in one step
+    *        accepted by automatic tuning.
+    */
+  void SetTuningAccuracy(qreal accuracy);
+
+  /**
+    * @brief Toggles deterministic mode, in which Bodies are merged in order
+    *        of their ids and hash of state is found after every step.
+    *        Forces do not depend on number of threads in any mode.
+    * @param deterministic Should results be reproducible bit by bit?
+    */
+  Q_INVOKABLE void SetDeterministic(bool deterministic);
+
+  /**
+    * @brief  Hash accessor.
+    * @retval Hash of state of all Bodies after last step. 0 if deterministic
+    *         mode is off.
+    */
+  quint64 GetStateHash();
+
+  /**
+    * @brief Toggles recording of trails behind Bodies.
+    * @param trails Should trails be recorded?
+    */
+  Q_INVOKABLE void SetTrails(bool trails);
+
+  /**
+    * @brief Trail length mutator.
+    * @param length Number of positions remembered in trail of each Body.
+    */
+  Q_INVOKABLE void SetTrailLength(int length);
+
+  /**
+    * @brief Adds new Body to simulation. Simulation takes its ownership.
+    * @param body New Body.
+    */
+  void AddBody(Body *body);
+
+  /**
+    * @brief Adds new Bodies to simulation. Simulation takes their ownership.
+    * @param bodies New Bodies.
+    */
+  Q_INVOKABLE void AddBodies(const QList<Body*> &bodies);
+
+  /**
+    * @brief  Removes topmost Body at given position.
+    * @param  position Position in Scene.
+    * @param  min_radius Bodies smaller than that are treated as if they had
+    *         that radius.
+    * @retval Was any Body removed?
+    */
+  Q_INVOKABLE bool RemoveBodyAt(QPointF position, qreal min_radius);
+
+  /**
+    * @brief Removes all Bodies.
+    */
+  Q_INVOKABLE void Clear();
+
+  /**
+    * @brief Advances simulation by given number of steps in calling thread.
+    *        Used when Simulation has no event loop.
+    * @param step_count Number of steps.
+    */
+  void Run(int step_count);
+
+  /**
+    * @brief  Body count accessor.
+    * @retval Number of Bodies.
+    */
+  int GetBodyCount();
+
+  /**
+    * @brief  Finds total kinetic and potential energy of Bodies.
+    * @retval Energy of Bodies.
+    */
+  qreal GetEnergy();
+
+  /**
+    * @brief  Finds where arrays which forces are summed from are placed.
+    *         Asks kernel about every page and waits for current step, so
+    *         window uses numbers sampled into Frame instead.
+    * @retval Bytes of arrays on each NUMA node [B].
+    */
+  QVector<qint64> GetNodeBytes();
+
+  /**
+    * @brief  Takes last published state of Bodies and asks for next one.
+    * @retval State of Bodies.
+    */
+  Frame TakeFrame();
+
+  /**
+    * @brief  Starts or stops publishing state of Bodies after every step
+    *         into shared memory.
+    * @param  name Name of shared memory object. Empty name stops
+    *         publishing.
+    * @retval Are snapshots published? SnapshotsFailed is also emitted when
+    *         they could not be started.
+    */
+  Q_INVOKABLE bool SetSnapshots(const QString &name);
+
+  /**
+    * @brief Sets queue which receives Frames during export.
+    * @param queue Queue of exported Frames.
+    */
+  void SetExportQueue(BoundedQueue<Frame> *queue);
+
+ public slots:
+  /**
+    * @brief Advances simulation as fast as possible and pushes every Frame
+    *        to be exported into export queue. Should be invoked in thread
+    *        of simulation while it is paused.
+    * @param frame_count Number of exported Frames.
+    * @param cadence Number of steps between exported Frames.
+    */
+  void Export(int frame_count, int cadence);
+
+ signals:
+  /**
+    * @brief Emitted when new Frame can be taken.
+    */
+  void FrameReady();
+
+  /**
+    * @brief Emitted when shared memory object for snapshots could not be
+    *        created.
+    */
+  void SnapshotsFailed();
+
+ private:
+  /**
+    * @brief Chooses Stepper matching current method and precision. Has to be
+    *        called with mutex_ locked.
+    */
+  void SelectStepper();
+
+  /**
+    * @brief Chooses solver, precision and number of threads for Bodies at
+    *        positions_. Has to be called with mutex_ locked.
+    */
+  void Tune();
+
+  /**
+    * @brief Sorts Bodies along Hilbert curve, so Bodies close in space are
+    *        close in arrays used by steppers. Has to be called with mutex_
+    *        locked.
+    */
+  void ReorderBodies();
+
+  /**
+    * @brief Finds all pairs of colliding Bodies at positions_, checking
+    *        only pairs from neighbor list.
+    */
+  void SweepCollisions();
+
+  /**
+    * @brief Find collision between Bodies.
+    * @param body_1 Body 1.
+    * @param body_2 Body 2.
+    * @param distance Distance between Bodies.
+    */
+  void FindCollisions(Body* body_1, Body* body_2, qreal distance);
+
+  /**
+    * @brief Finds all Bodies colliding with each other,
+    *        creating local collision group.
+    * @param body Reference Body.
+    */
+  void CollidingGroupSearch(Body *body);
+
+  /**
+    * @brief Merges Bodies together if collision occurred.
+    */
+  void ResolveCollisions();
+
+  /**
+    * @brief Advances simulation by one time step. Has to be called with
+    *        mutex_ locked.
+    */
+  void Step();
+
+  /**
+    * @brief  Copies state of Bodies. Has to be called with mutex_ locked.
+    * @retval State of Bodies.
+    */
+  Frame BuildFrame() const;
+
+  /**
+    * @brief Publishes state of Bodies for drawing. Has to be called with
+    *        mutex_ locked.
+    * @param force Should Frame be published even if previous one was not
+    *        taken yet?
+    */
+  void Publish(bool force);
+
+  // Timer for advancing simulation in equal time intervals.
+  QTimer *advancing_timer_;
+  // Guards Bodies and parameters of simulation.
+  QMutex mutex_;
+  QList<Body*> body_list_;
+  // Identifier given to next added Body.
+  quint32 next_id_;
+  // All Bodies which are currently colliding.
+  QList<Body*> collision_list_;
+  // Bodies which are currently colliding with each other in local group.
+  QList<Body*> local_collision_list_;
+  // Time step used in calculations of positon and velocity of Bodies.
+  qreal time_step_;
+  // Method of integration of motion.
+  Method method_;
+  // Tolerance of adaptive method.
+  qreal tolerance_;
+  Precision precision_;
+  Solver solver_;
+  Softening softening_;
+  qreal softening_length_;
+  // Advances Bodies with chosen method and precision.
+  Stepper *stepper_;
+  // Threads used by stepper_.
+  WorkerPool *pool_;
+  // Number of NUMA nodes of machine.
+  int node_count_;
+  // Bytes of force arrays of stepper_ on each NUMA node.
+  QVector<qint64> node_bytes_;
+  // Requested number of threads, 0 for number of processor cores.
+  int thread_count_;
+  // Are threads of pool_ pinned to processor cores?
+  bool pinned_;
+  // Are solver, precision and threads chosen by tuner_?
+  bool autotune_;
+  AutoTuner tuner_;
+  // Are Bodies merged in order of ids and state hashed after every step?
+  bool deterministic_;
+  // Hash of state of all Bodies after last step.
+  quint64 state_hash_;
+  // State of Bodies at beginning of step, in the same order as body_list_.
+  QVector<QPointF> positions_;
+  QVector<QPointF> velocities_;
+  // Masses of Bodies which pull others, 0 for test particles.
+  QVector<qreal> masses_;
+  QVector<quint32> ids_;
+  // Integrates tight pairs of Bodies separately.
+  BinaryRegularizer regularizer_;
+  // State of Bodies with tight pairs joined into their barycenters.
+  QVector<quint32> bulk_ids_;
+  QVector<QPointF> bulk_positions_;
+  QVector<QPointF> bulk_velocities_;
+  QVector<qreal> bulk_masses_;
+  // Positions of Bodies on Hilbert curve, used for sorting them.
+  QVector<std::pair<quint32, Body*> > curve_order_;
+  // Radii of Bodies at beginning of step.
+  QVector<qreal> radii_;
+  // Pairs of Bodies which can collide, kept between steps.
+  NeighborList neighbor_list_;
+  // Are trails recorded?
+  bool trails_;
+  // Number of positions remembered in trail of each Body.
+  int trail_length_;
+  // Guards frame_.
+  QMutex frame_mutex_;
+  // Last published state of Bodies.
+  Frame frame_;
+  // Set when last Frame was taken and next one should be published.
+  QAtomicInt frame_wanted_;
+  // Number of steps simulated so far.
+  quint64 step_;
+  // Simulated time.
+  qreal time_;
+  // Publishes snapshots into shared memory if open.
+  SnapshotWriter snapshot_writer_;
+  // Receives Frames during export.
+  BoundedQueue<Frame> *export_queue_;
+
+ private slots:
+  /**
+    * @brief Starts advancing simulation. Runs in thread of simulation.
+    */
+  void Start();
+
+  /**
+    * @brief Stops advancing simulation. Runs in thread of simulation.
+    */
+  void Stop();
+
+  /**
+    * @brief Updates velocity and position of Bodies.
+    */
+  void Advance();
+};
+
+#endif // SIMULATION_H
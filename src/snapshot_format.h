@@ -0,0 +1,150 @@
+/**
+  ******************************************************************************
+  * @file    snapshot_format.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Layout of shared memory with snapshots of simulation.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef SNAPSHOT_FORMAT_H
+#define SNAPSHOT_FORMAT_H
+
+// This file does not depend on Qt, so external readers can include it.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Atomics in shared memory work between processes only if they are lock-free.
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+              "Snapshots need lock-free atomics.");
+
+// Name of shared memory object used by default.
+#define SNAPSHOT_DEFAULT_NAME "/2d_nbody_snapshots"
+
+// Identifies shared memory object with snapshots ("NBOD").
+const uint32_t kSnapshotMagic = 0x4e424f44;
+// Changed whenever layout below changes.
+const uint32_t kSnapshotVersion = 1;
+// Largest quantized coordinate.
+const uint32_t kSnapshotQuantMax = 65535;
+
+/**
+  * @brief Beginning of shared memory object. It is followed by slot_count
+  *        slots. Snapshot with sequence number n is stored in slot
+  *        n % slot_count. Offsets are found by functions below.
+  */
+struct SnapshotHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t slot_count;
+  // Maximum number of Bodies in one slot.
+  uint32_t capacity;
+  // Sequence number of the newest complete snapshot, 0 if there is none.
+  std::atomic<uint64_t> latest;
+  // Set when writer removed this object, e.g. to create bigger one. Readers
+  // should open it again.
+  std::atomic<uint32_t> closed;
+  // Process id of writer. Another writer replaces object only when this
+  // process is gone. Fits into former padding, so offsets did not change.
+  uint32_t writer_pid;
+};
+
+/**
+  * @brief Beginning of slot. It is followed by arrays of capacity elements:
+  *        quantized x and y coordinates (uint16_t), masses (float) and
+  *        identifiers (uint32_t) of Bodies.
+  *
+  *        Writer sets sequence to 0 before it changes slot and to sequence
+  *        number of snapshot after it is done. Reader has to check that
+  *        sequence is the same before and after reading slot.
+  */
+struct SnapshotSlot {
+  std::atomic<uint64_t> sequence;
+  // Number of steps simulated before snapshot was taken.
+  uint64_t step;
+  // Simulated time.
+  double time;
+  // Position of Body is origin + quantized coordinate * scale.
+  double origin_x;
+  double origin_y;
+  double scale_x;
+  double scale_y;
+  // Number of Bodies.
+  uint32_t count;
+  uint32_t reserved;
+};
+
+// Offsets of arrays from beginning of slot [B].
+inline uint64_t SnapshotXOffset() {
+  return sizeof(SnapshotSlot);
+}
+
+inline uint64_t SnapshotYOffset(uint32_t capacity) {
+  return SnapshotXOffset() + capacity * sizeof(uint16_t);
+}
+
+inline uint64_t SnapshotMassesOffset(uint32_t capacity) {
+  return SnapshotYOffset(capacity) + capacity * sizeof(uint16_t);
+}
+
+inline uint64_t SnapshotIdsOffset(uint32_t capacity) {
+  return SnapshotMassesOffset(capacity) + capacity * sizeof(float);
+}
+
+/**
+  * @brief  Finds size of slot.
+  * @param  capacity Maximum number of Bodies in slot.
+  * @retval Size of slot [B], multiple of 8.
+  */
+inline uint64_t SnapshotSlotSize(uint32_t capacity) {
+  return (SnapshotIdsOffset(capacity) + capacity * sizeof(uint32_t) + 7) /
+         8 * 8;
+}
+
+/**
+  * @brief  Finds offset of slot from beginning of shared memory object.
+  * @param  slot_count Number of slots.
+  * @param  capacity Maximum number of Bodies in slot.
+  * @param  sequence Sequence number of snapshot stored in slot.
+  * @retval Offset of slot [B].
+  */
+inline uint64_t SnapshotSlotOffset(uint32_t slot_count, uint32_t capacity,
+                                   uint64_t sequence) {
+  return (sizeof(SnapshotHeader) + 7) / 8 * 8 +
+         (sequence % slot_count) * SnapshotSlotSize(capacity);
+}
+
+/**
+  * @brief  Finds size of whole shared memory object.
+  * @param  slot_count Number of slots.
+  * @param  capacity Maximum number of Bodies in slot.
+  * @retval Size of object [B].
+  */
+inline uint64_t SnapshotObjectSize(uint32_t slot_count, uint32_t capacity) {
+  return SnapshotSlotOffset(slot_count, capacity, slot_count - 1) +
+         SnapshotSlotSize(capacity);
+}
+
+#endif // SNAPSHOT_FORMAT_H
@@ -0,0 +1,218 @@
+/**
+  ******************************************************************************
+  * @file    snapshot_writer.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   SnapshotWriter class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "snapshot_writer.h"
+
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+  * @brief  Checks if shared memory object is used by running writer.
+  * @param  name Name of shared memory object.
+  * @retval Does process which created object still exist?
+  */
+static bool IsWriterAlive(const char *name) {
+  int fd = shm_open(name, O_RDONLY, 0);
+  if (fd < 0)
+    return false;
+  struct stat status;
+  void *memory = MAP_FAILED;
+  if (fstat(fd, &status) == 0 &&
+      status.st_size >= static_cast<off_t>(sizeof(SnapshotHeader)))
+    memory = mmap(NULL, sizeof(SnapshotHeader), PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED)
+    return false;
+  const SnapshotHeader *header = static_cast<SnapshotHeader*>(memory);
+  bool alive = header->magic == kSnapshotMagic &&
+               header->closed.load(std::memory_order_acquire) == 0 &&
+               header->writer_pid != 0;
+  // Process of other user can not be signalled, but it exists.
+  if (alive)
+    alive = kill(header->writer_pid, 0) == 0 || errno == EPERM;
+  munmap(memory, sizeof(SnapshotHeader));
+  return alive;
+}
+#endif
+
+SnapshotWriter::SnapshotWriter()
+    : header_(NULL),
+      size_(0),
+      sequence_(0) {
+}
+
+SnapshotWriter::~SnapshotWriter() {
+  Close();
+}
+
+bool SnapshotWriter::Open(const QString &name) {
+  Close();
+  name_ = name.toLocal8Bit();
+  return Map(kMinCapacity);
+}
+
+void SnapshotWriter::Close() {
+  Unmap();
+  name_.clear();
+}
+
+bool SnapshotWriter::IsOpen() const {
+  return header_ != NULL;
+}
+
+void SnapshotWriter::Write(quint64 step, qreal time,
+                           const QList<Body*> &bodies) {
+  if (!header_)
+    return;
+  const quint32 count = bodies.count();
+  if (count > header_->capacity) {
+    // Readers notice that object was closed and open the new one.
+    const quint32 capacity = std::max(count, 2 * header_->capacity);
+    Unmap();
+    if (!Map(capacity))
+      return;
+  }
+
+  // Coordinates are quantized within bounding box of all Bodies.
+  qreal left = 0.0;
+  qreal right = 0.0;
+  qreal top = 0.0;
+  qreal bottom = 0.0;
+  for (quint32 i = 0; i < count; ++i) {
+    const QPointF position = bodies.at(i)->GetPosition();
+    if (i == 0 || position.x() < left)
+      left = position.x();
+    if (i == 0 || position.x() > right)
+      right = position.x();
+    if (i == 0 || position.y() < top)
+      top = position.y();
+    if (i == 0 || position.y() > bottom)
+      bottom = position.y();
+  }
+  const qreal scale_x = std::max(right - left, 1e-9) / kSnapshotQuantMax;
+  const qreal scale_y = std::max(bottom - top, 1e-9) / kSnapshotQuantMax;
+
+  const quint64 sequence = ++sequence_;
+  const quint32 capacity = header_->capacity;
+  char *slot_data = reinterpret_cast<char*>(header_) +
+                    SnapshotSlotOffset(header_->slot_count, capacity,
+                                       sequence);
+  SnapshotSlot *slot = reinterpret_cast<SnapshotSlot*>(slot_data);
+  // Readers which are still reading this slot will notice the change.
+  slot->sequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot->step = step;
+  slot->time = time;
+  slot->origin_x = left;
+  slot->origin_y = top;
+  slot->scale_x = scale_x;
+  slot->scale_y = scale_y;
+  slot->count = count;
+  quint16 *xs = reinterpret_cast<quint16*>(slot_data + SnapshotXOffset());
+  quint16 *ys = reinterpret_cast<quint16*>(slot_data +
+                                           SnapshotYOffset(capacity));
+  float *masses = reinterpret_cast<float*>(slot_data +
+                                           SnapshotMassesOffset(capacity));
+  quint32 *ids = reinterpret_cast<quint32*>(slot_data +
+                                            SnapshotIdsOffset(capacity));
+  for (quint32 i = 0; i < count; ++i) {
+    const Body *body = bodies.at(i);
+    const QPointF position = body->GetPosition();
+    xs[i] = static_cast<quint16>(
+        std::lround((position.x() - left) / scale_x));
+    ys[i] = static_cast<quint16>(
+        std::lround((position.y() - top) / scale_y));
+    masses[i] = body->GetMass();
+    ids[i] = body->GetId();
+  }
+
+  slot->sequence.store(sequence, std::memory_order_release);
+  header_->latest.store(sequence, std::memory_order_release);
+}
+
+bool SnapshotWriter::Map(quint32 capacity) {
+#ifdef Q_OS_UNIX
+  int fd = shm_open(name_.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  // Object left by crashed process is replaced, but other running
+  // simulation keeps its own.
+  if (fd < 0 && errno == EEXIST && !IsWriterAlive(name_.constData())) {
+    shm_unlink(name_.constData());
+    fd = shm_open(name_.constData(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  }
+  if (fd < 0)
+    return false;
+  const quint64 size = SnapshotObjectSize(kSlotCount, capacity);
+  void *memory = MAP_FAILED;
+  if (ftruncate(fd, size) == 0)
+    memory = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (memory == MAP_FAILED) {
+    shm_unlink(name_.constData());
+    return false;
+  }
+
+  // New object is filled with zeros, so all slots are empty. Magic number
+  // is written last, so readers do not use half initialized header.
+  header_ = static_cast<SnapshotHeader*>(memory);
+  size_ = size;
+  header_->version = kSnapshotVersion;
+  header_->slot_count = kSlotCount;
+  header_->capacity = capacity;
+  header_->writer_pid = getpid();
+  std::atomic_thread_fence(std::memory_order_release);
+  header_->magic = kSnapshotMagic;
+  return true;
+#else
+  Q_UNUSED(capacity);
+  return false;
+#endif
+}
+
+void SnapshotWriter::Unmap() {
+#ifdef Q_OS_UNIX
+  if (!header_)
+    return;
+  header_->closed.store(1, std::memory_order_release);
+  munmap(header_, size_);
+  shm_unlink(name_.constData());
+  header_ = NULL;
+  size_ = 0;
+#endif
+}
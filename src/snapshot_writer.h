@@ -0,0 +1,110 @@
+/**
+  ******************************************************************************
+  * @file    snapshot_writer.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of SnapshotWriter class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef SNAPSHOT_WRITER_H
+#define SNAPSHOT_WRITER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+
+#include "body.h"
+#include "snapshot_format.h"
+
+/**
+  * @brief Publishes state of Bodies into POSIX shared memory, where any
+  *        number of other processes can read it without slowing down
+  *        simulation. Layout is described in snapshot_format.h.
+  */
+class SnapshotWriter {
+ public:
+  // Number of snapshots kept in shared memory.
+  static constexpr int kSlotCount = 8;
+  // Smallest number of Bodies which fit into one slot.
+  static constexpr int kMinCapacity = 1024;
+
+  SnapshotWriter();
+
+  /**
+    * @brief SnapshotWriter destructor. Removes shared memory object.
+    */
+  ~SnapshotWriter();
+
+  /**
+    * @brief  Creates shared memory object. Existing one with the same name
+    *         is replaced only if process which created it is gone.
+    * @param  name Name of shared memory object, starting with '/'.
+    * @retval Was object created? False if other process publishes
+    *         under the same name.
+    */
+  bool Open(const QString &name);
+
+  /**
+    * @brief Marks shared memory object as closed and removes it.
+    */
+  void Close();
+
+  /**
+    * @brief  Checks if snapshots are published.
+    * @retval Is shared memory object open?
+    */
+  bool IsOpen() const;
+
+  /**
+    * @brief Stores state of Bodies as the newest snapshot. Shared memory
+    *        object is replaced with bigger one if Bodies do not fit.
+    * @param step Number of steps simulated so far.
+    * @param time Simulated time.
+    * @param bodies Bodies to be stored.
+    */
+  void Write(quint64 step, qreal time, const QList<Body*> &bodies);
+
+ private:
+  /**
+    * @brief  Creates and maps shared memory object.
+    * @param  capacity Maximum number of Bodies in one slot.
+    * @retval Was object created?
+    */
+  bool Map(quint32 capacity);
+
+  /**
+    * @brief Unmaps and removes shared memory object.
+    */
+  void Unmap();
+
+  // Name of shared memory object.
+  QByteArray name_;
+  // Mapped shared memory object, NULL if closed.
+  SnapshotHeader *header_;
+  quint64 size_;
+  // Sequence number of the last written snapshot.
+  quint64 sequence_;
+};
+
+#endif // SNAPSHOT_WRITER_H
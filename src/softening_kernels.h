@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file    softening_kernels.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of softening kernels.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef SOFTENING_KERNELS_H
+#define SOFTENING_KERNELS_H
+
+#include <QtGlobal>
+#include <algorithm>
+#include <cmath>
+
+// Softening kernels shape gravity at short distances. Each one gives factor
+// by which mass times distance vector is multiplied to get acceleration,
+// 1 / distance^3 far away, and matching potential. Both are branch-free, so
+// summation loops stay vectorized.
+
+/**
+  * @brief Newtonian gravity cut off at minimal distance. Bodies closer than
+  *        that do not pull each other.
+  */
+template <typename Scalar>
+struct CutoffKernel {
+  /**
+    * @brief CutoffKernel constructor.
+    * @param length Minimal distance.
+    */
+  explicit CutoffKernel(qreal length)
+      : length_squared(static_cast<Scalar>(length * length)) {}
+
+  /**
+    * @brief  Finds pull factor.
+    * @param  distance_squared Square of distance between Bodies.
+    * @retval Acceleration divided by mass and distance vector.
+    */
+  Scalar Factor(Scalar distance_squared) const {
+    // Body itself and very close ones are skipped by selecting zero
+    // instead of branching.
+    const Scalar far = distance_squared > length_squared;
+    const Scalar safe_squared = std::max(distance_squared, length_squared);
+    return far / (safe_squared * std::sqrt(safe_squared));
+  }
+
+  /**
+    * @brief  Finds potential.
+    * @param  distance_squared Square of distance between Bodies.
+    * @retval Potential energy divided by both masses.
+    */
+  Scalar Potential(Scalar distance_squared) const {
+    return -1 / std::sqrt(std::max(distance_squared, length_squared));
+  }
+
+  Scalar length_squared;
+};
+
+/**
+  * @brief Plummer softening. Bodies pull each other as if their mass was
+  *        spread into spheres of softening length.
+  */
+template <typename Scalar>
+struct PlummerKernel {
+  /**
+    * @brief PlummerKernel constructor.
+    * @param length Softening length.
+    */
+  explicit PlummerKernel(qreal length)
+      : length_squared(static_cast<Scalar>(length * length)) {}
+
+  /**
+    * @brief  Finds pull factor.
+    * @param  distance_squared Square of distance between Bodies.
+    * @retval Acceleration divided by mass and distance vector.
+    */
+  Scalar Factor(Scalar distance_squared) const {
+    const Scalar softened = distance_squared + length_squared;
+    return 1 / (softened * std::sqrt(softened));
+  }
+
+  /**
+    * @brief  Finds potential.
+    * @param  distance_squared Square of distance between Bodies.
+    * @retval Potential energy divided by both masses.
+    */
+  Scalar Potential(Scalar distance_squared) const {
+    return -1 / std::sqrt(distance_squared + length_squared);
+  }
+
+  Scalar length_squared;
+};
+
+/**
+  * @brief Cubic spline softening (Monaghan and Lattanzio). Gravity is
+  *        exactly Newtonian beyond 2.8 softening lengths, which makes it
+  *        as soft as Plummer kernel at centre.
+  */
+template <typename Scalar>
+struct SplineKernel {
+  /**
+    * @brief SplineKernel constructor.
+    * @param length Softening length, equivalent to Plummer one.
+    */
+  explicit SplineKernel(qreal length)
+      : support(static_cast<Scalar>(2.8 * length)),
+        inverse_support(static_cast<Scalar>(1.0 / (2.8 * length))) {}
+
+  /**
+    * @brief  Finds pull factor.
+    * @param  distance_squared Square of distance between Bodies.
+    * @retval Acceleration divided by mass and distance vector.
+    */
+  Scalar Factor(Scalar distance_squared) const {
+    const Scalar distance = std::sqrt(distance_squared);
+    const Scalar u = distance * inverse_support;
+    const Scalar inverse_cubed = inverse_support * inverse_support *
+                                 inverse_support;
+    // All three parts are computed at arguments clamped to their ranges
+    // and the right one is selected by multiplying with comparison.
+    const Scalar u_1 = std::min(u, Scalar(0.5));
+    const Scalar inner = inverse_cubed *
+        (Scalar(32.0 / 3.0) + u_1 * u_1 * (Scalar(32.0) * u_1 -
+                                           Scalar(38.4)));
+    const Scalar u_2 = std::min(std::max(u, Scalar(0.5)), Scalar(1.0));
+    const Scalar middle = inverse_cubed *
+        (Scalar(64.0 / 3.0) - Scalar(48.0) * u_2 +
+         Scalar(38.4) * u_2 * u_2 - Scalar(32.0 / 3.0) * u_2 * u_2 * u_2 -
+         Scalar(1.0 / 15.0) / (u_2 * u_2 * u_2));
+    const Scalar safe = std::max(distance, support);
+    const Scalar outer = 1 / (safe * safe * safe);
+    return (u < Scalar(0.5)) * inner +
+           (u >= Scalar(0.5) && u < Scalar(1.0)) * middle +
+           (u >= Scalar(1.0)) * outer;
+  }
+
+  /**
+    * @brief  Finds potential.
+    * @param  distance_squared Square of distance between Bodies.
+    * @retval Potential energy divided by both masses.
+    */
+  Scalar Potential(Scalar distance_squared) const {
+    const Scalar distance = std::sqrt(distance_squared);
+    const Scalar u = distance * inverse_support;
+    const Scalar u_1 = std::min(u, Scalar(0.5));
+    const Scalar inner = inverse_support *
+        (Scalar(-2.8) + u_1 * u_1 * (Scalar(16.0 / 3.0) + u_1 * u_1 *
+                                     (Scalar(6.4) * u_1 - Scalar(9.6))));
+    const Scalar u_2 = std::min(std::max(u, Scalar(0.5)), Scalar(1.0));
+    const Scalar middle = inverse_support *
+        (Scalar(-3.2) + Scalar(1.0 / 15.0) / u_2 +
+         u_2 * u_2 * (Scalar(32.0 / 3.0) + u_2 * (Scalar(-16.0) +
+                      u_2 * (Scalar(9.6) - Scalar(32.0 / 15.0) * u_2))));
+    const Scalar outer = -1 / std::max(distance, support);
+    return (u < Scalar(0.5)) * inner +
+           (u >= Scalar(0.5) && u < Scalar(1.0)) * middle +
+           (u >= Scalar(1.0)) * outer;
+  }
+
+  // Distance beyond which gravity is Newtonian.
+  Scalar support;
+  Scalar inverse_support;
+};
+
+#endif // SOFTENING_KERNELS_H
@@ -0,0 +1,101 @@
+/**
+  ******************************************************************************
+  * @file    spatial_grid.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   SpatialGrid class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtMath>
+
+SpatialGrid::SpatialGrid()
+    : margin_(0.0),
+      columns_(0),
+      rows_(0),
+      cell_width_(1.0),
+      cell_height_(1.0) {}
+
+void SpatialGrid::Build(const QVector<QPointF> &centers, const QRectF &bounds,
+                        qreal margin) {
+  const int count = centers.size();
+  bounds_ = bounds;
+  margin_ = margin;
+  columns_ = qCeil(std::sqrt(count / qreal(kObjectsPerCell)));
+  if (columns_ < 1)
+    columns_ = 1;
+  else if (columns_ > kMaxCells)
+    columns_ = kMaxCells;
+  rows_ = columns_;
+  cell_width_ = bounds_.width() > 0.0 ? bounds_.width() / columns_ : 1.0;
+  cell_height_ = bounds_.height() > 0.0 ? bounds_.height() / rows_ : 1.0;
+
+  // Counting sort of objects by their cells.
+  cell_starts_.fill(0, columns_ * rows_ + 1);
+  cells_.resize(count);
+  for (int i = 0; i < count; ++i) {
+    const QPointF &center = centers.at(i);
+    int column = qBound(0, Column(center.x()), columns_ - 1);
+    int row = qBound(0, Row(center.y()), rows_ - 1);
+    cells_[i] = row * columns_ + column;
+    ++cell_starts_[cells_[i] + 1];
+  }
+  for (int i = 1; i < cell_starts_.size(); ++i)
+    cell_starts_[i] += cell_starts_[i - 1];
+  indices_.resize(count);
+  QVector<int> next = cell_starts_;
+  for (int i = 0; i < count; ++i)
+    indices_[next[cells_[i]]++] = i;
+}
+
+void SpatialGrid::Query(const QRectF &rect, QVector<int> *indices) const {
+  if (indices_.isEmpty())
+    return;
+  // Objects are sorted by centers, so rectangle is extended by margin.
+  int first_column = std::max(Column(rect.left() - margin_), 0);
+  int last_column = std::min(Column(rect.right() + margin_), columns_ - 1);
+  int first_row = std::max(Row(rect.top() - margin_), 0);
+  int last_row = std::min(Row(rect.bottom() + margin_), rows_ - 1);
+  for (int row = first_row; row <= last_row; ++row) {
+    for (int column = first_column; column <= last_column; ++column) {
+      int cell = row * columns_ + column;
+      for (int i = cell_starts_.at(cell); i < cell_starts_.at(cell + 1); ++i)
+        indices->append(indices_.at(i));
+    }
+  }
+}
+
+int SpatialGrid::Column(qreal x) const {
+  qreal column = std::floor((x - bounds_.left()) / cell_width_);
+  return static_cast<int>(qBound<qreal>(-1.0, column, columns_));
+}
+
+int SpatialGrid::Row(qreal y) const {
+  qreal row = std::floor((y - bounds_.top()) / cell_height_);
+  return static_cast<int>(qBound<qreal>(-1.0, row, rows_));
+}
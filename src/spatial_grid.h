@@ -0,0 +1,100 @@
+/**
+  ******************************************************************************
+  * @file    spatial_grid.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of SpatialGrid class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+/**
+  * @brief Uniform grid of cells with indices of objects whose centers lie in
+  *        them. Used for finding objects in visible part of Scene without
+  *        checking all of them.
+  */
+class SpatialGrid {
+ public:
+  // Average number of objects in one cell.
+  static constexpr int kObjectsPerCell = 8;
+  // Maximum number of cells along one axis.
+  static constexpr int kMaxCells = 1024;
+
+  /**
+    * @brief SpatialGrid constructor.
+    */
+  SpatialGrid();
+
+  /**
+    * @brief Sorts objects into cells.
+    * @param centers Centers of objects.
+    * @param bounds Rectangle containing all centers.
+    * @param margin Greatest distance of any part of object from its center.
+    */
+  void Build(const QVector<QPointF> &centers, const QRectF &bounds,
+             qreal margin);
+
+  /**
+    * @brief Finds objects which can intersect rectangle.
+    * @param rect Searched rectangle.
+    * @param indices Vector to which indices of objects are appended.
+    */
+  void Query(const QRectF &rect, QVector<int> *indices) const;
+
+ private:
+  /**
+    * @brief  Finds cell column of position.
+    * @param  x Horizontal position.
+    * @retval Column, which can be outside of grid.
+    */
+  int Column(qreal x) const;
+
+  /**
+    * @brief  Finds cell row of position.
+    * @param  y Vertical position.
+    * @retval Row, which can be outside of grid.
+    */
+  int Row(qreal y) const;
+
+  QRectF bounds_;
+  qreal margin_;
+  int columns_;
+  int rows_;
+  qreal cell_width_;
+  qreal cell_height_;
+  // Index of first object of each cell in indices_. Last element is number
+  // of objects.
+  QVector<int> cell_starts_;
+  // Indices of objects sorted by cells.
+  QVector<int> indices_;
+  // Cell of each object, kept to avoid reallocation.
+  QVector<int> cells_;
+};
+
+#endif // SPATIAL_GRID_H
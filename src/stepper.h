@@ -0,0 +1,121 @@
+/**
+  ******************************************************************************
+  * @file    stepper.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of Stepper class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef STEPPER_H
+#define STEPPER_H
+
+#include <QPointF>
+#include <QVector>
+
+#include "worker_pool.h"
+
+/**
+  * @brief Advances positions and velocities of Bodies by one time step.
+  *        Concrete steppers are chosen once, when method or precision of
+  *        simulation changes, so only one virtual call is made per step.
+  */
+class Stepper {
+ public:
+  /**
+    * @brief Stepper destructor.
+    */
+  virtual ~Stepper() {}
+
+  /**
+    * @brief Advances Bodies by one time step.
+    * @param time_step Time step.
+    * @param masses Masses of Bodies which pull others, 0 for test
+    *        particles.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  virtual void Advance(qreal time_step, const QVector<qreal> &masses,
+                       QVector<QPointF> *positions,
+                       QVector<QPointF> *velocities) = 0;
+
+  /**
+    * @brief Tolerance mutator. Used only by adaptive methods.
+    * @param tolerance Largest relative error of one step.
+    */
+  virtual void SetTolerance(qreal tolerance) = 0;
+
+  /**
+    * @brief Ids mutator. Lets force policies which keep state between
+    *        steps tell which Bodies stayed when Bodies change.
+    * @param ids Ids of Bodies, indexed like arrays of next steps.
+    */
+  virtual void SetIds(const QVector<quint32> &ids) = 0;
+
+  /**
+    * @brief Adds bytes of arrays which threads sum forces from to NUMA
+    *        nodes where they are.
+    * @param node_bytes Bytes on each node.
+    */
+  virtual void CountNodeBytes(QVector<qint64> *node_bytes) const = 0;
+};
+
+/**
+  * @brief Stepper composed at compile time from integration and force
+  *        policies. Calls between them are resolved statically, so every
+  *        combination gets its own inlined inner loops.
+  */
+template <template <class> class Integrator, class Solver>
+class PolicyStepper : public Stepper {
+ public:
+  /**
+    * @brief PolicyStepper constructor.
+    * @param grav_constant Gravitational constant.
+    * @param softening_length Softening length of force policy.
+    * @param pool Threads which may be used by policies.
+    */
+  PolicyStepper(qreal grav_constant, qreal softening_length, WorkerPool *pool)
+      : solver_(grav_constant, softening_length, pool) {}
+
+  void Advance(qreal time_step, const QVector<qreal> &masses,
+               QVector<QPointF> *positions, QVector<QPointF> *velocities) {
+    integrator_.Advance(time_step, &solver_, masses, positions, velocities);
+  }
+
+  void SetTolerance(qreal tolerance) {
+    integrator_.SetTolerance(tolerance);
+  }
+
+  void SetIds(const QVector<quint32> &ids) {
+    solver_.SetIds(ids);
+  }
+
+  void CountNodeBytes(QVector<qint64> *node_bytes) const {
+    solver_.CountNodeBytes(node_bytes);
+  }
+
+ private:
+  Integrator<Solver> integrator_;
+  Solver solver_;
+};
+
+#endif // STEPPER_H
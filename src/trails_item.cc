@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    trails_item.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   TrailsItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "trails_item.h"
+
+#include <algorithm>
+
+#include <QStyleOptionGraphicsItem>
+
+TrailsItem::TrailsItem()
+    : QGraphicsItem() {
+  // Needed for exposed rectangle to be passed to paint().
+  setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void TrailsItem::Sync(const Frame &frame) {
+  // Vectors are shared with Frame, not copied.
+  points_ = frame.trail_points;
+  offsets_ = frame.trail_offsets;
+  const int count = std::max(offsets_.size() - 1, 0);
+  bounds_.resize(count);
+  centers_.resize(count);
+
+  QRectF rect;
+  qreal margin = 0.0;
+  for (int i = 0; i < count; ++i) {
+    const int begin = offsets_.at(i);
+    const int end = offsets_.at(i + 1);
+    qreal left = 0.0;
+    qreal right = 0.0;
+    qreal top = 0.0;
+    qreal bottom = 0.0;
+    for (int j = begin; j < end; ++j) {
+      const QPointF &point = points_.at(j);
+      if (j == begin || point.x() < left)
+        left = point.x();
+      if (j == begin || point.x() > right)
+        right = point.x();
+      if (j == begin || point.y() < top)
+        top = point.y();
+      if (j == begin || point.y() > bottom)
+        bottom = point.y();
+    }
+    bounds_[i] = QRectF(QPointF(left, top), QPointF(right, bottom));
+    centers_[i] = bounds_.at(i).center();
+    margin = std::max(margin, std::max(bounds_.at(i).width(),
+                                       bounds_.at(i).height()) / 2.0);
+    if (end - begin > 1)
+      rect = rect.isNull() ? bounds_.at(i) : rect.united(bounds_.at(i));
+  }
+  grid_.Build(centers_, rect, margin);
+
+  if (rect != bounding_rect_) {
+    prepareGeometryChange();
+    bounding_rect_ = rect;
+  }
+  update();
+}
+
+void TrailsItem::Clear() {
+  points_.clear();
+  offsets_.clear();
+  bounds_.clear();
+  centers_.clear();
+  grid_.Build(centers_, QRectF(), 0.0);
+  prepareGeometryChange();
+  bounding_rect_ = QRectF();
+  update();
+}
+
+QRectF TrailsItem::boundingRect() const {
+  return bounding_rect_;
+}
+
+void TrailsItem::paint(QPainter *painter,
+                       const QStyleOptionGraphicsItem *option,
+                       QWidget *widget) {
+  Q_UNUSED(widget);
+  const QRectF exposed = option->exposedRect;
+  QPen pen(Qt::white, kTrailWidth);
+  pen.setCosmetic(true);
+  painter->setPen(pen);
+  visible_.clear();
+  grid_.Query(exposed, &visible_);
+  foreach (int i, visible_) {
+    const int size = offsets_.at(i + 1) - offsets_.at(i);
+    const QRectF &bounds = bounds_.at(i);
+    // Trails outside of exposed rectangle are skipped. Trails can have zero
+    // width or height, so QRectF::intersects() cannot be used.
+    if (size < 2 ||
+        bounds.right() < exposed.left() || bounds.left() > exposed.right() ||
+        bounds.bottom() < exposed.top() || bounds.top() > exposed.bottom())
+      continue;
+    painter->drawPolyline(points_.constData() + offsets_.at(i), size);
+  }
+}
@@ -0,0 +1,95 @@
+/**
+  ******************************************************************************
+  * @file    trails_item.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of TrailsItem class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef TRAILS_ITEM_H
+#define TRAILS_ITEM_H
+
+#include <QGraphicsItem>
+#include <QPainter>
+#include <QVector>
+
+#include "frame.h"
+#include "spatial_grid.h"
+
+/**
+  * @brief Single graphics item which draws trails of all Bodies as polylines
+  *        with cosmetic pen, so their width does not depend on zoom.
+  */
+class TrailsItem : public QGraphicsItem {
+ public:
+  // Width of trails on screen [px].
+  static constexpr qreal kTrailWidth = 0.25;
+
+  /**
+    * @brief TrailsItem constructor.
+    */
+  TrailsItem();
+
+  /**
+    * @brief Takes trails to be drawn.
+    * @param frame State of Bodies with their trails.
+    */
+  void Sync(const Frame &frame);
+
+  /**
+    * @brief Removes all trails.
+    */
+  void Clear();
+
+  /**
+    * @brief  Bounding rectangle accessor.
+    * @retval Rectangle containing all trails.
+    */
+  QRectF boundingRect() const;
+
+  /**
+    * @brief Draws all trails which are inside exposed rectangle.
+    * @param painter Painter.
+    * @param option Style options with exposed rectangle.
+    * @param widget Widget being painted on.
+    */
+  void paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
+             QWidget *widget);
+
+ private:
+  // Points of all trails, from the oldest to the newest one of each Body.
+  QVector<QPointF> points_;
+  // Index of first point of each trail. Last element is number of points.
+  QVector<int> offsets_;
+  // Bounding rectangles of each trail, used for culling.
+  QVector<QRectF> bounds_;
+  QRectF bounding_rect_;
+  // Trails sorted by centers of their bounding rectangles.
+  SpatialGrid grid_;
+  QVector<QPointF> centers_;
+  // Indices of trails found in exposed rectangle during last paint call.
+  QVector<int> visible_;
+};
+
+#endif // TRAILS_ITEM_H
@@ -0,0 +1,588 @@
+/**
+  ******************************************************************************
+  * @file    tree_solver.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of TreeSolver class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef TREE_SOLVER_H
+#define TREE_SOLVER_H
+
+#include <QHash>
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+
+#include "first_touch_array.h"
+#include "softening_kernels.h"
+#include "worker_pool.h"
+
+/**
+  * @brief Force policy which approximates distant groups of Bodies by their
+  *        mass at center of mass (Barnes-Hut quadtree). Bodies move little
+  *        in one step, so tree is kept between calls: bounds and masses of
+  *        nodes are refitted in place, Bodies added or merged are inserted
+  *        into their leaves, and whole tree is rebuilt only when too many
+  *        Bodies left cells of their leaves. Each Body is pulled in fixed
+  *        order, so results are the same for any number of threads.
+  */
+template <typename Scalar, template <typename> class Kernel = CutoffKernel>
+class TreeSolver {
+ public:
+  // Number of Bodies pulled in one task.
+  static constexpr int kBlockSize = 64;
+  // Leaf with more Bodies than that is split into four.
+  static constexpr int kLeafSize = 8;
+  // Leaves are not split deeper, so coincident Bodies do not split forever.
+  static constexpr int kMaxDepth = 32;
+  // Node is replaced by its mass if it is seen from pulled Body at angle
+  // smaller than that [rad].
+  static constexpr qreal kOpeningAngle = 0.5;
+  // Fraction of Bodies which may be out of cells of their leaves or
+  // inserted since last rebuild.
+  static constexpr qreal kMaxImbalance = 0.1;
+  // Body is out of cell of its leaf when it is farther from its center
+  // than that many halves of its size. Refitted bounds cover it anyway, so
+  // only traversal gets slower.
+  static constexpr qreal kLooseness = 2.0;
+
+  /**
+    * @brief TreeSolver constructor.
+    * @param grav_constant Gravitational constant.
+    * @param softening_length Softening length of Kernel.
+    * @param pool Threads which sum forces.
+    */
+  TreeSolver(qreal grav_constant, qreal softening_length, WorkerPool *pool)
+      : grav_constant_(grav_constant),
+        kernel_(softening_length),
+        pool_(pool),
+        ids_known_(false),
+        escaped_(0),
+        inserted_(0),
+        source_count_(0) {}
+
+  /**
+    * @brief  Gravitational constant accessor.
+    * @retval Gravitational constant.
+    */
+  qreal GetGravConstant() const {
+    return grav_constant_;
+  }
+
+  /**
+    * @brief Ids mutator. Ids tell which Bodies stayed, so they keep their
+    *        leaves when Bodies are added, removed or reordered.
+    * @param ids Ids of Bodies, indexed like positions in next calls.
+    */
+  void SetIds(const QVector<quint32> &ids) {
+    ids_ = ids;
+    ids_known_ = true;
+  }
+
+  /**
+    * @brief Finds gravitational acceleration of every Body.
+    * @param positions Positions of Bodies.
+    * @param masses Masses of Bodies. Bodies with mass 0 are only pulled and
+    *        are left out of tree.
+    * @param accelerations Accelerations of Bodies.
+    */
+  void Accelerate(const QVector<QPointF> &positions,
+                  const QVector<qreal> &masses,
+                  QVector<QPointF> *accelerations) {
+    Accelerate(positions.size(), positions, masses, accelerations);
+  }
+
+  /**
+    * @brief Finds gravitational acceleration of first Bodies. Others only
+    *        pull them.
+    * @param pulled_count Number of pulled Bodies. Value 0 only fits tree to
+    *        Bodies.
+    * @param positions Positions of Bodies.
+    * @param masses Masses of Bodies.
+    * @param accelerations Accelerations of pulled Bodies.
+    */
+  void Accelerate(int pulled_count, const QVector<QPointF> &positions,
+                  const QVector<qreal> &masses,
+                  QVector<QPointF> *accelerations) {
+    Gather(positions, masses);
+    if (!Remap(positions, masses))
+      Build(positions, masses);
+    Refit(positions);
+    if (escaped_ + inserted_ > kMaxImbalance * source_count_) {
+      Build(positions, masses);
+      Refit(positions);
+    }
+
+    accelerations->resize(pulled_count);
+    QPointF *result = accelerations->data();
+    const int block_count = (pulled_count + kBlockSize - 1) / kBlockSize;
+    pool_->Run(block_count, [&](int block, int) {
+      const int begin = block * kBlockSize;
+      const int end = std::min(begin + kBlockSize, pulled_count);
+      for (int i = begin; i < end; ++i)
+        result[i] = Pull(i) * grav_constant_;
+    });
+  }
+
+  /**
+    * @brief Adds bytes of Bodies in Scalar to NUMA nodes where they are.
+    * @param node_bytes Bytes on each node.
+    */
+  void CountNodeBytes(QVector<qint64> *node_bytes) const {
+    x_.CountNodeBytes(node_bytes);
+    y_.CountNodeBytes(node_bytes);
+    mass_.CountNodeBytes(node_bytes);
+  }
+
+  /**
+    * @brief Appends sources which pull every point of rectangle as tree
+    *        does: Nodes far from whole rectangle as their mass at center
+    *        of mass, and Bodies of opened leaves one by one. That is
+    *        locally essential tree of Bodies in rectangle. Uses tree of
+    *        last call of Accelerate.
+    * @param box Rectangle containing pulled Bodies.
+    * @param positions Positions of sources.
+    * @param masses Masses of sources.
+    */
+  void Export(const QRectF &box, QVector<QPointF> *positions,
+              QVector<qreal> *masses) const {
+    if (nodes_.isEmpty())
+      return;
+    const Scalar left = static_cast<Scalar>(box.left() - origin_.x());
+    const Scalar right = static_cast<Scalar>(box.right() - origin_.x());
+    const Scalar top = static_cast<Scalar>(box.top() - origin_.y());
+    const Scalar bottom = static_cast<Scalar>(box.bottom() - origin_.y());
+    int stack[3 * kMaxDepth + 4];
+    int top_of_stack = 0;
+    stack[top_of_stack++] = 0;
+    while (top_of_stack > 0) {
+      const Node &node = nodes_.at(stack[--top_of_stack]);
+      if (node.mass <= 0)
+        continue;
+      // Distance to the nearest point of rectangle.
+      const Scalar delta_x = std::max(std::max(left - node.x, node.x - right),
+                                      Scalar(0));
+      const Scalar delta_y = std::max(std::max(top - node.y, node.y - bottom),
+                                      Scalar(0));
+      if (delta_x * delta_x + delta_y * delta_y > node.open_squared) {
+        positions->append(QPointF(node.x, node.y) + origin_);
+        masses->append(node.mass);
+      } else if (node.first_child >= 0) {
+        for (int c = node.first_child; c < node.first_child + 4; ++c)
+          stack[top_of_stack++] = c;
+      } else {
+        for (int i = node.first_body; i >= 0; i = next_body_.at(i)) {
+          positions->append(QPointF(x_.at(i), y_.at(i)) + origin_);
+          masses->append(mass_.at(i));
+        }
+      }
+    }
+  }
+
+ private:
+  // Cell of quadtree.
+  struct Node {
+    // Square in which Bodies are inserted, fixed since it was created.
+    qreal center_x;
+    qreal center_y;
+    qreal half_size;
+    int depth;
+    // Index of first of four children, -1 for leaf.
+    int first_child;
+    // First Body of leaf, next ones are linked through next_body_.
+    int first_body;
+    int body_count;
+    // Refitted before every call, relative to origin_.
+    Scalar mass;
+    Scalar x;
+    Scalar y;
+    Scalar min_x;
+    Scalar min_y;
+    Scalar max_x;
+    Scalar max_y;
+    // Node is opened when pulled Body is closer to its center of mass.
+    Scalar open_squared;
+  };
+
+  /**
+    * @brief Copies positions relative to center of mass and masses in
+    *        Scalar.
+    * @param positions Positions of Bodies.
+    * @param masses Masses of Bodies.
+    */
+  void Gather(const QVector<QPointF> &positions,
+              const QVector<qreal> &masses) {
+    const int count = positions.size();
+    qreal total_mass = 0.0;
+    QPointF center(0.0, 0.0);
+    for (int i = 0; i < count; ++i) {
+      total_mass += masses.at(i);
+      center += positions.at(i) * masses.at(i);
+    }
+    origin_ = total_mass > 0.0 ? center / total_mass : QPointF(0.0, 0.0);
+    x_.Resize(count, kBlockSize, pool_);
+    y_.Resize(count, kBlockSize, pool_);
+    mass_.Resize(count, kBlockSize, pool_);
+    for (int i = 0; i < count; ++i) {
+      x_[i] = static_cast<Scalar>(positions.at(i).x() - origin_.x());
+      y_[i] = static_cast<Scalar>(positions.at(i).y() - origin_.y());
+      mass_[i] = static_cast<Scalar>(masses.at(i));
+    }
+  }
+
+  /**
+    * @brief  Moves Bodies which are still in tree into their leaves at new
+    *         indices and inserts new ones.
+    * @param  positions Positions of Bodies.
+    * @param  masses Masses of Bodies.
+    * @retval Can tree be kept?
+    */
+  bool Remap(const QVector<QPointF> &positions,
+             const QVector<qreal> &masses) {
+    const int count = positions.size();
+    if (nodes_.isEmpty())
+      return false;
+    // The same Bodies in the same order keep everything.
+    if (leaf_of_.size() == count && (!ids_known_ || ids_ == tree_ids_))
+      return true;
+    if (!ids_known_ || ids_.size() != count)
+      return false;
+
+    QHash<quint32, int> old_index;
+    old_index.reserve(tree_ids_.size());
+    for (int i = 0; i < tree_ids_.size(); ++i)
+      old_index.insert(tree_ids_.at(i), i);
+    old_leaf_of_.swap(leaf_of_);
+    leaf_of_.fill(-1, count);
+    next_body_.resize(count);
+    for (int n = 0; n < nodes_.size(); ++n) {
+      nodes_[n].first_body = -1;
+      nodes_[n].body_count = 0;
+    }
+    // Kept Bodies are linked before any leaf is split by new ones.
+    new_bodies_.clear();
+    source_count_ = 0;
+    for (int i = 0; i < count; ++i) {
+      if (masses.at(i) <= 0.0)
+        continue;
+      ++source_count_;
+      const int old = old_index.value(ids_.at(i), -1);
+      const int leaf = old >= 0 ? old_leaf_of_.at(old) : -1;
+      if (leaf >= 0)
+        Link(i, leaf);
+      else
+        new_bodies_.append(i);
+    }
+    foreach (int body, new_bodies_)
+      Insert(body, positions);
+    inserted_ += new_bodies_.size();
+    tree_ids_ = ids_;
+    return true;
+  }
+
+  /**
+    * @brief Builds tree anew around all Bodies with mass.
+    * @param positions Positions of Bodies.
+    * @param masses Masses of Bodies.
+    */
+  void Build(const QVector<QPointF> &positions,
+             const QVector<qreal> &masses) {
+    const int count = positions.size();
+    qreal min_x = 0.0;
+    qreal min_y = 0.0;
+    qreal max_x = 0.0;
+    qreal max_y = 0.0;
+    bool first = true;
+    for (int i = 0; i < count; ++i) {
+      if (masses.at(i) <= 0.0)
+        continue;
+      const QPointF &position = positions.at(i);
+      if (first) {
+        min_x = max_x = position.x();
+        min_y = max_y = position.y();
+        first = false;
+      }
+      min_x = std::min(min_x, position.x());
+      min_y = std::min(min_y, position.y());
+      max_x = std::max(max_x, position.x());
+      max_y = std::max(max_y, position.y());
+    }
+    Node root;
+    root.center_x = (min_x + max_x) / 2.0;
+    root.center_y = (min_y + max_y) / 2.0;
+    // Slightly larger, so Bodies on edges are inside.
+    root.half_size = std::max(max_x - min_x, max_y - min_y) * 0.5001 + 1e-9;
+    root.depth = 0;
+    root.first_child = -1;
+    root.first_body = -1;
+    root.body_count = 0;
+    nodes_.clear();
+    nodes_.append(root);
+    leaf_of_.fill(-1, count);
+    next_body_.resize(count);
+    source_count_ = 0;
+    for (int i = 0; i < count; ++i) {
+      if (masses.at(i) > 0.0) {
+        ++source_count_;
+        Insert(i, positions);
+      }
+    }
+    inserted_ = 0;
+    tree_ids_ = ids_known_ ? ids_ : QVector<quint32>();
+  }
+
+  /**
+    * @brief Adds Body to leaf.
+    * @param body Index of Body.
+    * @param leaf Index of leaf.
+    */
+  void Link(int body, int leaf) {
+    next_body_[body] = nodes_.at(leaf).first_body;
+    nodes_[leaf].first_body = body;
+    ++nodes_[leaf].body_count;
+    leaf_of_[body] = leaf;
+  }
+
+  /**
+    * @brief  Finds child of Node whose cell contains position.
+    * @param  node Index of Node with children.
+    * @param  position Position.
+    * @retval Index of child.
+    */
+  int ChildAt(int node, const QPointF &position) const {
+    const Node &parent = nodes_.at(node);
+    return parent.first_child + (position.x() >= parent.center_x ? 1 : 0) +
+           (position.y() >= parent.center_y ? 2 : 0);
+  }
+
+  /**
+    * @brief Inserts Body into leaf whose cell contains it, splitting leaf
+    *        if it gets too full. Bodies outside root go to its nearest leaf.
+    * @param body Index of Body.
+    * @param positions Positions of Bodies.
+    */
+  void Insert(int body, const QVector<QPointF> &positions) {
+    int node = 0;
+    while (nodes_.at(node).first_child >= 0)
+      node = ChildAt(node, positions.at(body));
+    Link(body, node);
+    Split(node, positions);
+  }
+
+  /**
+    * @brief Splits leaf into four while it has too many Bodies.
+    * @param leaf Index of leaf.
+    * @param positions Positions of Bodies.
+    */
+  void Split(int leaf, const QVector<QPointF> &positions) {
+    if (nodes_.at(leaf).body_count <= kLeafSize ||
+        nodes_.at(leaf).depth >= kMaxDepth)
+      return;
+    const int first_child = nodes_.size();
+    const qreal quarter = nodes_.at(leaf).half_size / 2.0;
+    for (int c = 0; c < 4; ++c) {
+      Node child;
+      child.center_x = nodes_.at(leaf).center_x +
+                       ((c & 1) != 0 ? quarter : -quarter);
+      child.center_y = nodes_.at(leaf).center_y +
+                       ((c & 2) != 0 ? quarter : -quarter);
+      child.half_size = quarter;
+      child.depth = nodes_.at(leaf).depth + 1;
+      child.first_child = -1;
+      child.first_body = -1;
+      child.body_count = 0;
+      nodes_.append(child);
+    }
+    int body = nodes_.at(leaf).first_body;
+    nodes_[leaf].first_child = first_child;
+    nodes_[leaf].first_body = -1;
+    nodes_[leaf].body_count = 0;
+    while (body >= 0) {
+      const int next = next_body_.at(body);
+      Link(body, ChildAt(leaf, positions.at(body)));
+      body = next;
+    }
+    for (int c = 0; c < 4; ++c)
+      Split(first_child + c, positions);
+  }
+
+  /**
+    * @brief Finds masses, centers of mass and bounds of all Nodes at
+    *        current positions, and counts Bodies out of cells of leaves.
+    * @param positions Positions of Bodies.
+    */
+  void Refit(const QVector<QPointF> &positions) {
+    escaped_ = 0;
+    const Scalar opening = static_cast<Scalar>(1.0 / kOpeningAngle);
+    // Children are always created after their parents.
+    for (int n = nodes_.size() - 1; n >= 0; --n) {
+      Node &node = nodes_[n];
+      Scalar mass = 0;
+      Scalar sum_x = 0;
+      Scalar sum_y = 0;
+      node.min_x = node.min_y = node.max_x = node.max_y = 0;
+      bool empty = true;
+      if (node.first_child < 0) {
+        const qreal loose_size = node.half_size * kLooseness;
+        for (int i = node.first_body; i >= 0; i = next_body_.at(i)) {
+          const QPointF &position = positions.at(i);
+          if (qAbs(position.x() - node.center_x) > loose_size ||
+              qAbs(position.y() - node.center_y) > loose_size)
+            ++escaped_;
+          mass += mass_.at(i);
+          sum_x += mass_.at(i) * x_.at(i);
+          sum_y += mass_.at(i) * y_.at(i);
+          Extend(&node, x_.at(i), y_.at(i), x_.at(i), y_.at(i), &empty);
+        }
+      } else {
+        for (int c = node.first_child; c < node.first_child + 4; ++c) {
+          const Node &child = nodes_.at(c);
+          if (child.mass <= 0)
+            continue;
+          mass += child.mass;
+          sum_x += child.mass * child.x;
+          sum_y += child.mass * child.y;
+          Extend(&node, child.min_x, child.min_y, child.max_x, child.max_y,
+                 &empty);
+        }
+      }
+      node.mass = mass;
+      if (mass <= 0)
+        continue;
+      node.x = sum_x / mass;
+      node.y = sum_y / mass;
+      // Bounding circle around center of mass is seen at opening angle
+      // from distance of its radius divided by angle.
+      const Scalar size = std::max(node.max_x - node.min_x,
+                                   node.max_y - node.min_y);
+      const Scalar offset_x = node.x - (node.min_x + node.max_x) / 2;
+      const Scalar offset_y = node.y - (node.min_y + node.max_y) / 2;
+      const Scalar radius = size * opening +
+                            std::sqrt(offset_x * offset_x +
+                                      offset_y * offset_y);
+      node.open_squared = radius * radius;
+    }
+  }
+
+  /**
+    * @brief Extends bounds of Node by rectangle.
+    * @param node Node.
+    * @param min_x Left edge of rectangle.
+    * @param min_y Top edge of rectangle.
+    * @param max_x Right edge of rectangle.
+    * @param max_y Bottom edge of rectangle.
+    * @param empty Are bounds still empty? Cleared by first rectangle.
+    */
+  static void Extend(Node *node, Scalar min_x, Scalar min_y, Scalar max_x,
+                     Scalar max_y, bool *empty) {
+    if (*empty) {
+      node->min_x = min_x;
+      node->min_y = min_y;
+      node->max_x = max_x;
+      node->max_y = max_y;
+      *empty = false;
+      return;
+    }
+    node->min_x = std::min(node->min_x, min_x);
+    node->min_y = std::min(node->min_y, min_y);
+    node->max_x = std::max(node->max_x, max_x);
+    node->max_y = std::max(node->max_y, max_y);
+  }
+
+  /**
+    * @brief  Sums pull of tree on Body.
+    * @param  body Index of pulled Body.
+    * @retval Acceleration before multiplying by gravitational constant.
+    */
+  QPointF Pull(int body) const {
+    const Scalar x = x_.at(body);
+    const Scalar y = y_.at(body);
+    qreal sum_x = 0.0;
+    qreal sum_y = 0.0;
+    // Every opened Node replaces itself with four children.
+    int stack[3 * kMaxDepth + 4];
+    int top = 0;
+    stack[top++] = 0;
+    while (top > 0) {
+      const Node &node = nodes_.at(stack[--top]);
+      if (node.mass <= 0)
+        continue;
+      const Scalar delta_x = node.x - x;
+      const Scalar delta_y = node.y - y;
+      const Scalar distance_squared = delta_x * delta_x + delta_y * delta_y;
+      if (distance_squared > node.open_squared) {
+        const Scalar factor = node.mass * kernel_.Factor(distance_squared);
+        sum_x += factor * delta_x;
+        sum_y += factor * delta_y;
+      } else if (node.first_child >= 0) {
+        for (int c = node.first_child; c < node.first_child + 4; ++c)
+          stack[top++] = c;
+      } else {
+        for (int i = node.first_body; i >= 0; i = next_body_.at(i)) {
+          const Scalar body_x = x_.at(i) - x;
+          const Scalar body_y = y_.at(i) - y;
+          const Scalar factor = mass_.at(i) *
+              kernel_.Factor(body_x * body_x + body_y * body_y);
+          sum_x += factor * body_x;
+          sum_y += factor * body_y;
+        }
+      }
+    }
+    return QPointF(sum_x, sum_y);
+  }
+
+  qreal grav_constant_;
+  Kernel<Scalar> kernel_;
+  WorkerPool *pool_;
+  // Ids of Bodies in next calls and in tree.
+  QVector<quint32> ids_;
+  QVector<quint32> tree_ids_;
+  // Were ids given at all?
+  bool ids_known_;
+  QVector<Node> nodes_;
+  // Leaf of each Body, -1 for Bodies without mass.
+  QVector<int> leaf_of_;
+  QVector<int> old_leaf_of_;
+  // Bodies which were not in tree before remapping.
+  QVector<int> new_bodies_;
+  // Next Body in the same leaf, -1 for last one.
+  QVector<int> next_body_;
+  // Number of Bodies out of cells of their leaves at last refit.
+  int escaped_;
+  // Number of Bodies inserted since last rebuild.
+  int inserted_;
+  // Number of Bodies in tree.
+  int source_count_;
+  // Center of mass, subtracted from positions.
+  QPointF origin_;
+  // Positions relative to origin_ and masses in Scalar. Bodies of each
+  // block are first touched by worker which pulls them.
+  FirstTouchArray<Scalar> x_;
+  FirstTouchArray<Scalar> y_;
+  FirstTouchArray<Scalar> mass_;
+};
+
+#endif // TREE_SOLVER_H
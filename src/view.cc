@@ -40,3 +40,13 @@ void View::SetZoomSlider(QSlider *zoom_slider) {
 void View::wheelEvent(QWheelEvent *event) {
   zoom_slider_->setValue(zoom_slider_->value() + event->angleDelta().y() / 12);
 }
+
+void View::scrollContentsBy(int dx, int dy) {
+  QGraphicsView::scrollContentsBy(dx, dy);
+  emit TransformChanged();
+}
+
+void View::resizeEvent(QResizeEvent *event) {
+  QGraphicsView::resizeEvent(event);
+  emit TransformChanged();
+}
@@ -31,12 +31,13 @@
 #define VIEW_H
 
 #include <QGraphicsView>
+#include <QResizeEvent>
 #include <QSlider>
 #include <QWheelEvent>
 
 /**
-  * @brief Object inherited from QGraphicsView just for capturing
-  *        mouse wheel event.
+  * @brief Object inherited from QGraphicsView for capturing mouse wheel event
+  *        and changes of visible part of Scene.
   */
 class View : public QGraphicsView {
   Q_OBJECT
@@ -54,6 +55,12 @@ class View : public QGraphicsView {
     */
   void SetZoomSlider(QSlider *zoom_slider);
 
+ signals:
+  /**
+    * @brief Emitted when View was panned or resized.
+    */
+  void TransformChanged();
+
  protected:
   /**
     * @brief Updates position of zoom slider after mouse wheel event.
@@ -61,6 +68,19 @@ class View : public QGraphicsView {
     */
   void wheelEvent(QWheelEvent *event);
 
+  /**
+    * @brief Scrolls View and notifies about it.
+    * @param dx Horizontal distance of scroll.
+    * @param dy Vertical distance of scroll.
+    */
+  void scrollContentsBy(int dx, int dy);
+
+  /**
+    * @brief Resizes View and notifies about it.
+    * @param event Event handler.
+    */
+  void resizeEvent(QResizeEvent *event);
+
  private:
   QSlider *zoom_slider_;
 };
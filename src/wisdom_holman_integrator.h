@@ -0,0 +1,403 @@
+/**
+  ******************************************************************************
+  * @file    wisdom_holman_integrator.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of WisdomHolmanIntegrator class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+#ifndef WISDOM_HOLMAN_INTEGRATOR_H
+#define WISDOM_HOLMAN_INTEGRATOR_H
+
+#include <QPointF>
+#include <QVector>
+#include <algorithm>
+#include <cmath>
+
+#include "kepler_drift.h"
+
+/**
+  * @brief Integration policy of Wisdom-Holman method in democratic
+  *        heliocentric coordinates, for systems dominated by one central
+  *        Body. Bodies move along exact Kepler orbits and are kicked only by
+  *        small remaining forces, so time step can be much longer than in
+  *        Euler or Runge-Kutta methods.
+  *
+  *        Hierarchy is found in every step. Body inside Hill sphere of more
+  *        massive planet is its moon. Planets with their moons move around
+  *        central Body as one system, while moons move along Kepler orbits
+  *        around their planets.
+  */
+template <class Solver>
+class WisdomHolmanIntegrator {
+ public:
+  /**
+    * @brief Tolerance mutator. Time step is fixed, so tolerance is not used.
+    * @param tolerance Largest error of one step.
+    */
+  void SetTolerance(qreal tolerance) {
+    Q_UNUSED(tolerance);
+  }
+
+  /**
+    * @brief Advances Bodies by one time step, using kick of interactions
+    *        between halves of drifts along Kepler orbits.
+    * @param time_step Time step.
+    * @param solver Force policy.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void Advance(qreal time_step, Solver *solver, const QVector<qreal> &masses,
+               QVector<QPointF> *positions, QVector<QPointF> *velocities) {
+    if (positions->isEmpty())
+      return;
+    FindHierarchy(masses, *positions);
+    if (!(masses.at(central_) > 0.0)) {
+      // There is no gravity at all.
+      for (int i = 0; i < positions->size(); ++i)
+        (*positions)[i] += velocities->at(i) * time_step;
+      return;
+    }
+    grav_constant_ = solver->GetGravConstant();
+    ToRelative(masses, *positions, *velocities);
+    const qreal half_step = time_step / 2.0;
+    Drift(half_step, masses);
+    Jump(half_step, masses);
+    ToPositions(masses, half_step, positions);
+    solver->Accelerate(*positions, masses, &accelerations_);
+    Kick(time_step, masses);
+    Jump(half_step, masses);
+    Drift(half_step, masses);
+    ToPositions(masses, time_step, positions);
+    ToVelocities(masses, velocities);
+  }
+
+ private:
+  /**
+    * @brief Finds central Body, planets and moons.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    */
+  void FindHierarchy(const QVector<qreal> &masses,
+                     const QVector<QPointF> &positions) {
+    const int count = positions.size();
+    central_ = std::max_element(masses.begin(), masses.end()) -
+               masses.begin();
+    by_mass_.clear();
+    for (int i = 0; i < count; ++i) {
+      if (i != central_)
+        by_mass_.append(i);
+    }
+    std::stable_sort(by_mass_.begin(), by_mass_.end(), [&](int a, int b) {
+      return masses.at(a) > masses.at(b);
+    });
+
+    parent_.fill(central_, count);
+    parent_[central_] = -1;
+    hill_squared_.resize(count);
+    planets_.clear();
+    moons_.clear();
+    const qreal central_mass = masses.at(central_);
+    const QPointF central_position = positions.at(central_);
+    foreach (int i, by_mass_) {
+      // Planets are found in order of mass, so every candidate for parent
+      // is already known.
+      int parent = -1;
+      qreal parent_distance_squared = 0.0;
+      foreach (int planet, planets_) {
+        if (!(masses.at(planet) > masses.at(i)))
+          break;
+        const QPointF delta = positions.at(i) - positions.at(planet);
+        const qreal distance_squared = delta.x() * delta.x() +
+                                       delta.y() * delta.y();
+        if (distance_squared < hill_squared_.at(planet) &&
+            (parent < 0 || distance_squared < parent_distance_squared)) {
+          parent = planet;
+          parent_distance_squared = distance_squared;
+        }
+      }
+      if (parent >= 0) {
+        parent_[i] = parent;
+        moons_.append(i);
+      } else {
+        planets_.append(i);
+        const QPointF delta = positions.at(i) - central_position;
+        const qreal hill_ratio = std::cbrt(masses.at(i) /
+                                           (3.0 * central_mass));
+        hill_squared_[i] = (delta.x() * delta.x() + delta.y() * delta.y()) *
+                           hill_ratio * hill_ratio;
+      }
+    }
+  }
+
+  /**
+    * @brief Converts positions and velocities into barycenter, heliocentric
+    *        positions and barycentric velocities of planetary systems, and
+    *        positions and velocities of moons relative to their systems.
+    * @param masses Masses of Bodies.
+    * @param positions Positions of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void ToRelative(const QVector<qreal> &masses,
+                  const QVector<QPointF> &positions,
+                  const QVector<QPointF> &velocities) {
+    const int count = positions.size();
+    system_mass_.fill(0.0, count);
+    system_position_.fill(QPointF(0.0, 0.0), count);
+    system_velocity_.fill(QPointF(0.0, 0.0), count);
+    relative_position_.resize(count);
+    relative_velocity_.resize(count);
+    total_mass_ = 0.0;
+    barycenter_position_ = QPointF(0.0, 0.0);
+    barycenter_velocity_ = QPointF(0.0, 0.0);
+    for (int i = 0; i < count; ++i) {
+      total_mass_ += masses.at(i);
+      barycenter_position_ += positions.at(i) * masses.at(i);
+      barycenter_velocity_ += velocities.at(i) * masses.at(i);
+      // Planets and moons are summed into their systems.
+      const int system = parent_.at(i) == central_ ? i : parent_.at(i);
+      if (system >= 0) {
+        system_mass_[system] += masses.at(i);
+        system_position_[system] += positions.at(i) * masses.at(i);
+        system_velocity_[system] += velocities.at(i) * masses.at(i);
+      }
+    }
+    barycenter_position_ /= total_mass_;
+    barycenter_velocity_ /= total_mass_;
+
+    const QPointF central_position = positions.at(central_);
+    foreach (int planet, planets_) {
+      // Test particles are systems without mass.
+      if (system_mass_.at(planet) > 0.0) {
+        system_position_[planet] /= system_mass_.at(planet);
+        system_velocity_[planet] /= system_mass_.at(planet);
+      } else {
+        system_position_[planet] = positions.at(planet);
+        system_velocity_[planet] = velocities.at(planet);
+      }
+      relative_position_[planet] = system_position_.at(planet) -
+                                   central_position;
+      relative_velocity_[planet] = system_velocity_.at(planet) -
+                                   barycenter_velocity_;
+    }
+    foreach (int moon, moons_) {
+      const int planet = parent_.at(moon);
+      relative_position_[moon] = positions.at(moon) - positions.at(planet);
+      relative_velocity_[moon] = velocities.at(moon) -
+                                 system_velocity_.at(planet);
+    }
+  }
+
+  /**
+    * @brief Moves planetary systems along Kepler orbits around central
+    *        Body and moons along Kepler orbits around their planets.
+    * @param time Duration of drift.
+    * @param masses Masses of Bodies.
+    */
+  void Drift(qreal time, const QVector<qreal> &masses) {
+    const qreal central_mu = grav_constant_ * masses.at(central_);
+    foreach (int planet, planets_) {
+      KeplerDrift(central_mu, time, &relative_position_[planet],
+                  &relative_velocity_[planet]);
+    }
+    foreach (int moon, moons_) {
+      KeplerDrift(grav_constant_ * masses.at(parent_.at(moon)), time,
+                  &relative_position_[moon], &relative_velocity_[moon]);
+    }
+  }
+
+  /**
+    * @brief Moves planetary systems and moons by momentum of their
+    *        siblings, which accounts for motion of central Body and
+    *        planets.
+    * @param time Duration of jump.
+    * @param masses Masses of Bodies.
+    */
+  void Jump(qreal time, const QVector<qreal> &masses) {
+    QPointF momentum(0.0, 0.0);
+    foreach (int planet, planets_)
+      momentum += relative_velocity_.at(planet) * system_mass_.at(planet);
+    const QPointF shift = momentum * (time / masses.at(central_));
+    foreach (int planet, planets_)
+      relative_position_[planet] += shift;
+
+    moon_sum_.fill(QPointF(0.0, 0.0), masses.size());
+    foreach (int moon, moons_)
+      moon_sum_[parent_.at(moon)] += relative_velocity_.at(moon) *
+                                     masses.at(moon);
+    foreach (int moon, moons_) {
+      const int planet = parent_.at(moon);
+      relative_position_[moon] += moon_sum_.at(planet) *
+                                  (time / masses.at(planet));
+    }
+  }
+
+  /**
+    * @brief Changes velocities by forces which are not part of Kepler
+    *        orbits: pull of other systems, tides and pull between moons.
+    * @param time Duration of kick.
+    * @param masses Masses of Bodies.
+    */
+  void Kick(qreal time, const QVector<qreal> &masses) {
+    // Acceleration of every planetary system is weighted average of
+    // accelerations of its members.
+    system_acceleration_.fill(QPointF(0.0, 0.0), masses.size());
+    foreach (int planet, planets_) {
+      system_acceleration_[planet] = accelerations_.at(planet) *
+                                     masses.at(planet);
+    }
+    foreach (int moon, moons_) {
+      system_acceleration_[parent_.at(moon)] += accelerations_.at(moon) *
+                                                masses.at(moon);
+    }
+    const qreal central_mu = grav_constant_ * masses.at(central_);
+    foreach (int planet, planets_) {
+      if (system_mass_.at(planet) > 0.0)
+        system_acceleration_[planet] /= system_mass_.at(planet);
+      else
+        system_acceleration_[planet] = accelerations_.at(planet);
+      relative_velocity_[planet] +=
+          (system_acceleration_.at(planet) -
+           KeplerAcceleration(central_mu, relative_position_.at(planet))) *
+          time;
+    }
+    foreach (int moon, moons_) {
+      const int planet = parent_.at(moon);
+      relative_velocity_[moon] +=
+          (accelerations_.at(moon) - system_acceleration_.at(planet) -
+           KeplerAcceleration(grav_constant_ * masses.at(planet),
+                              relative_position_.at(moon))) * time;
+    }
+  }
+
+  /**
+    * @brief  Finds acceleration towards center of Kepler orbit.
+    * @param  mu Gravitational parameter of center.
+    * @param  position Position relative to center.
+    * @retval Acceleration.
+    */
+  static QPointF KeplerAcceleration(qreal mu, const QPointF &position) {
+    const qreal distance_squared = position.x() * position.x() +
+                                   position.y() * position.y();
+    if (distance_squared == 0.0)
+      return QPointF(0.0, 0.0);
+    return position * (-mu / (distance_squared * std::sqrt(distance_squared)));
+  }
+
+  /**
+    * @brief Converts relative coordinates back into positions.
+    * @param masses Masses of Bodies.
+    * @param time Time since beginning of step.
+    * @param positions Positions of Bodies.
+    */
+  void ToPositions(const QVector<qreal> &masses, qreal time,
+                   QVector<QPointF> *positions) {
+    // Barycenter moves along straight line.
+    QPointF central_position = barycenter_position_ +
+                               barycenter_velocity_ * time;
+    foreach (int planet, planets_) {
+      central_position -= relative_position_.at(planet) *
+                          (system_mass_.at(planet) / total_mass_);
+    }
+    (*positions)[central_] = central_position;
+
+    moon_sum_.fill(QPointF(0.0, 0.0), masses.size());
+    foreach (int moon, moons_)
+      moon_sum_[parent_.at(moon)] += relative_position_.at(moon) *
+                                     masses.at(moon);
+    foreach (int planet, planets_) {
+      QPointF position = central_position + relative_position_.at(planet);
+      if (system_mass_.at(planet) > 0.0)
+        position -= moon_sum_.at(planet) / system_mass_.at(planet);
+      (*positions)[planet] = position;
+    }
+    foreach (int moon, moons_) {
+      (*positions)[moon] = positions->at(parent_.at(moon)) +
+                           relative_position_.at(moon);
+    }
+  }
+
+  /**
+    * @brief Converts relative coordinates back into velocities.
+    * @param masses Masses of Bodies.
+    * @param velocities Velocities of Bodies.
+    */
+  void ToVelocities(const QVector<qreal> &masses,
+                    QVector<QPointF> *velocities) {
+    QPointF central_velocity = barycenter_velocity_;
+    foreach (int planet, planets_) {
+      central_velocity -= relative_velocity_.at(planet) *
+                          (system_mass_.at(planet) / masses.at(central_));
+    }
+    (*velocities)[central_] = central_velocity;
+
+    moon_sum_.fill(QPointF(0.0, 0.0), masses.size());
+    foreach (int moon, moons_)
+      moon_sum_[parent_.at(moon)] += relative_velocity_.at(moon) *
+                                     masses.at(moon);
+    foreach (int planet, planets_) {
+      system_velocity_[planet] = relative_velocity_.at(planet) +
+                                 barycenter_velocity_;
+      QPointF velocity = system_velocity_.at(planet);
+      if (masses.at(planet) > 0.0)
+        velocity -= moon_sum_.at(planet) / masses.at(planet);
+      (*velocities)[planet] = velocity;
+    }
+    foreach (int moon, moons_) {
+      (*velocities)[moon] = system_velocity_.at(parent_.at(moon)) +
+                            relative_velocity_.at(moon);
+    }
+  }
+
+  qreal grav_constant_;
+  // Most massive Body.
+  int central_;
+  // Central Body for planets, planet for moons, -1 for central Body.
+  QVector<int> parent_;
+  // Bodies other than central one, from the most massive.
+  QVector<int> by_mass_;
+  QVector<int> planets_;
+  QVector<int> moons_;
+  // Squares of radii of Hill spheres of planets.
+  QVector<qreal> hill_squared_;
+  qreal total_mass_;
+  QPointF barycenter_position_;
+  QPointF barycenter_velocity_;
+  // Mass, barycenter, velocity and acceleration of planetary systems,
+  // indexed by their planets.
+  QVector<qreal> system_mass_;
+  QVector<QPointF> system_position_;
+  QVector<QPointF> system_velocity_;
+  QVector<QPointF> system_acceleration_;
+  // Heliocentric positions and barycentric velocities of planetary
+  // systems. Positions of moons relative to planets and velocities
+  // relative to their systems.
+  QVector<QPointF> relative_position_;
+  QVector<QPointF> relative_velocity_;
+  // Sums over moons of each planet.
+  QVector<QPointF> moon_sum_;
+  QVector<QPointF> accelerations_;
+};
+
+#endif // WISDOM_HOLMAN_INTEGRATOR_H
@@ -0,0 +1,181 @@
+/**
+  ******************************************************************************
+  * @file    worker_pool.cc
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   WorkerPool class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#include "worker_pool.h"
+
+#include <QThread>
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+WorkerPool::WorkerPool(int thread_count, bool pinned)
+    : pinned_(pinned),
+      generation_(0),
+      busy_(0),
+      stop_(false),
+      function_(NULL),
+      task_count_(0),
+      next_task_(0),
+      busy_time_(0) {
+  if (thread_count <= 0)
+    thread_count = QThread::idealThreadCount();
+  for (int i = 1; i < thread_count; ++i)
+    threads_.push_back(std::thread(&WorkerPool::Loop, this, i));
+#ifdef Q_OS_LINUX
+  // Calling thread is worker 0. It is pinned once here rather than in
+  // every Run, and only after workers were started with its own affinity.
+  caller_ = std::this_thread::get_id();
+  caller_pinned_ = pinned_ &&
+      pthread_getaffinity_np(pthread_self(), sizeof(caller_affinity_),
+                             &caller_affinity_) == 0;
+  if (caller_pinned_)
+    Pin(0);
+#endif
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+  for (std::thread &thread : threads_)
+    thread.join();
+#ifdef Q_OS_LINUX
+  // Pool destroyed by other thread, e.g. after thread of simulation ended,
+  // leaves its affinity alone.
+  if (caller_pinned_ && caller_ == std::this_thread::get_id()) {
+    pthread_setaffinity_np(pthread_self(), sizeof(caller_affinity_),
+                           &caller_affinity_);
+  }
+#endif
+}
+
+int WorkerPool::GetThreadCount() const {
+  return static_cast<int>(threads_.size()) + 1;
+}
+
+bool WorkerPool::IsPinned() const {
+  return pinned_;
+}
+
+double WorkerPool::GetBusySeconds() const {
+  return std::chrono::duration<double>(busy_time_).count();
+}
+
+void WorkerPool::Run(int task_count,
+                     const std::function<void(int, int)> &function) {
+  const std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  // Pinned pool gives single task to its worker as well, so the same
+  // thread always touches it.
+  if (threads_.empty() || (task_count <= 1 && !pinned_)) {
+    for (int i = 0; i < task_count; ++i)
+      function(i, 0);
+    busy_time_ += std::chrono::steady_clock::now() - start;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    function_ = &function;
+    task_count_ = task_count;
+    next_task_ = 0;
+    busy_ = static_cast<int>(threads_.size());
+    ++generation_;
+  }
+  start_.notify_all();
+  Work(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return busy_ == 0; });
+  function_ = NULL;
+  busy_time_ += std::chrono::steady_clock::now() - start;
+}
+
+void WorkerPool::Loop(int worker) {
+  if (pinned_)
+    Pin(worker);
+  unsigned generation = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      start_.wait(lock, [&] { return stop_ || generation_ != generation; });
+      if (stop_)
+        return;
+      generation = generation_;
+    }
+    Work(worker);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--busy_ == 0)
+        done_.notify_one();
+    }
+  }
+}
+
+void WorkerPool::Work(int worker) {
+  if (pinned_) {
+    // Worker gets the same share of tasks in every call with the same
+    // number of tasks, so it works on the same part of arrays.
+    const qint64 task_count = task_count_;
+    const int worker_count = GetThreadCount();
+    const int begin = static_cast<int>(task_count * worker / worker_count);
+    const int end =
+        static_cast<int>(task_count * (worker + 1) / worker_count);
+    for (int task = begin; task < end; ++task)
+      (*function_)(task, worker);
+    return;
+  }
+  for (int task = next_task_++; task < task_count_; task = next_task_++)
+    (*function_)(task, worker);
+}
+
+void WorkerPool::Pin(int worker) {
+#ifdef Q_OS_LINUX
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return;
+  // Cores are usually numbered node by node, so consecutive workers fill
+  // one node before the next.
+  int skipped = worker % CPU_COUNT(&allowed);
+  for (int core = 0; core < CPU_SETSIZE; ++core) {
+    if (!CPU_ISSET(core, &allowed) || skipped-- > 0)
+      continue;
+    cpu_set_t pinned;
+    CPU_ZERO(&pinned);
+    CPU_SET(core, &pinned);
+    pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned);
+    return;
+  }
+#else
+  Q_UNUSED(worker);
+#endif
+}
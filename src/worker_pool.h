@@ -0,0 +1,146 @@
+/**
+  ******************************************************************************
+  * @file    worker_pool.h
+  * @author  2D N-Body Gravity Simulator contributors
+  * @version V1.0.0
+  * @date    18-October-2026
+  * @brief   Header file of WorkerPool class.
+  ******************************************************************************
+  * @attention
+  *
+  * This file is part of 2D N-Body Gravity Simulator.
+  *
+  * 2D N-Body Gravity Simulator is free software: you can redistribute it and/or
+  * modify it under the terms of the GNU General Public License as published by
+  * the Free Software Foundation, either version 3 of the License, or
+  * (at your option) any later version.
+  *
+  * 2D N-Body Gravity Simulator is distributed in the hope that it will be
+  * useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+  * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  * GNU General Public License for more details.
+  *
+  * You should have received a copy of the GNU General Public License
+  * along with 2D N-Body Gravity Simulator.
+  * If not, see <http://www.gnu.org/licenses/>.
+  *
+  ******************************************************************************
+  */
+
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef Q_OS_LINUX
+#include <sched.h>
+#endif
+
+/**
+  * @brief Group of threads which execute numbered tasks in parallel. Calling
+  *        thread takes part in work as worker 0. Pinned pool keeps each
+  *        of its threads on one processor core, and gives each worker the
+  *        same tasks every time. Memory first touched by a worker then stays
+  *        on its NUMA node.
+  */
+class WorkerPool {
+ public:
+  /**
+    * @brief WorkerPool constructor. Pinned pool has to be used by thread
+    *        which created it, which stays on the first core until pool is
+    *        destroyed.
+    * @param thread_count Number of threads including calling one. Value 0
+    *        means number of processor cores.
+    * @param pinned Should threads be pinned to processor cores and tasks
+    *        split statically?
+    */
+  explicit WorkerPool(int thread_count = 0, bool pinned = false);
+
+  /**
+    * @brief WorkerPool destructor. Stops all threads and gives calling
+    *        thread of pinned pool its own affinity back.
+    */
+  ~WorkerPool();
+
+  /**
+    * @brief  Thread count accessor.
+    * @retval Number of threads including calling one.
+    */
+  int GetThreadCount() const;
+
+  /**
+    * @brief  Pinning accessor.
+    * @retval Are threads pinned to processor cores?
+    */
+  bool IsPinned() const;
+
+  /**
+    * @brief  Busy time accessor.
+    * @retval Total time spent in Run [s].
+    */
+  double GetBusySeconds() const;
+
+  /**
+    * @brief Executes tasks and waits until all of them are finished.
+    *        Tasks are taken in order of their numbers by first free worker.
+    *        In pinned pool each worker executes contiguous range of tasks
+    *        instead, which depends only on number of tasks.
+    * @param task_count Number of tasks.
+    * @param function Function called with number of task and number of
+    *        worker executing it.
+    */
+  void Run(int task_count, const std::function<void(int, int)> &function);
+
+ private:
+  /**
+    * @brief Main loop of worker thread.
+    * @param worker Number of worker.
+    */
+  void Loop(int worker);
+
+  /**
+    * @brief Executes tasks until there are none left.
+    * @param worker Number of worker.
+    */
+  void Work(int worker);
+
+  /**
+    * @brief Pins calling thread to processor core.
+    * @param worker Number of worker. Worker n runs on n-th core the process
+    *        may use.
+    */
+  static void Pin(int worker);
+
+  std::vector<std::thread> threads_;
+  // Are threads pinned and tasks split statically?
+  const bool pinned_;
+#ifdef Q_OS_LINUX
+  // Thread which created pool and its affinity before it was pinned.
+  std::thread::id caller_;
+  cpu_set_t caller_affinity_;
+  bool caller_pinned_;
+#endif
+  std::mutex mutex_;
+  // Wakes workers when new tasks are available.
+  std::condition_variable start_;
+  // Wakes calling thread when all workers are done.
+  std::condition_variable done_;
+  // Incremented every time new tasks are available.
+  unsigned generation_;
+  // Number of workers still executing current tasks.
+  int busy_;
+  bool stop_;
+  const std::function<void(int, int)> *function_;
+  int task_count_;
+  std::atomic<int> next_task_;
+  // Total time spent in Run.
+  std::chrono::steady_clock::duration busy_time_;
+};
+
+#endif // WORKER_POOL_H